@@ -14,14 +14,347 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <cmath>
+#include <deque>
+#include <mutex>
+
+// map_file and save_to_file use mmap on POSIX systems
+#if defined(__unix__) or defined(__APPLE__)
+#define BIGINT_MMAP
+#include <cerrno>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// the add and subtract kernels pick AVX2 or AVX-512, and the multiply kernels MULX/ADX, at 
+// runtime on x86-64 with GCC or Clang, unless BIGINT_NO_SIMD is defined
+#if defined(__x86_64__) and (defined(__GNUC__) or defined(__clang__)) and !defined(BIGINT_NO_SIMD)
+#define BIGINT_X86_DISPATCH
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
 
+/**********************************************************************
+**************************** LIMB STORAGE *****************************
+**********************************************************************/
+
+// number of limbs stored inside a limb_vector before it moves to the heap (128 bits)
+const size_t LIMB_VECTOR_INLINE_CAPACITY = 2;
+
+/**
+ * @brief contiguous storage of 64-bit limbs with a small inline buffer, so values that 
+ * fit in LIMB_VECTOR_INLINE_CAPACITY limbs never allocate. It moves to the heap only 
+ * when it grows past the inline buffer.
+ */
+class limb_vector
+{
+    public:
+        // empty limb_vector
+        limb_vector();
+        // limb_vector of count limbs, all equal to value
+        limb_vector(size_t count, uint64_t value = 0);
+        // copy and move
+        limb_vector(const limb_vector&);
+        limb_vector(limb_vector&&) noexcept;
+        ~limb_vector();
+        limb_vector& operator=(const limb_vector&);
+        limb_vector& operator=(limb_vector&&) noexcept;
+
+        // size and capacity
+        size_t size() const;
+        bool empty() const;
+        size_t capacity() const;
+        bool is_inline() const;
+
+        // element access
+        uint64_t* data();
+        const uint64_t* data() const;
+        uint64_t& operator[](size_t);
+        const uint64_t& operator[](size_t) const;
+        uint64_t& back();
+        const uint64_t& back() const;
+        uint64_t* begin();
+        uint64_t* end();
+        const uint64_t* begin() const;
+        const uint64_t* end() const;
+
+        // modifiers
+        void push_back(uint64_t);
+        void pop_back();
+        void clear();
+        void resize(size_t count, uint64_t value = 0);
+        void reserve(size_t);
+
+    private:
+        uint64_t* limbs;
+        size_t count;
+        size_t cap;
+        uint64_t inline_limbs[LIMB_VECTOR_INLINE_CAPACITY];
+
+        // releases heap storage if there is any
+        void release();
+};
+
+/**
+ * @brief Default Constructor of an empty limb_vector, using the inline buffer
+ * 
+ */
+limb_vector::limb_vector() 
+    : limbs(inline_limbs), count(0), cap(LIMB_VECTOR_INLINE_CAPACITY)
+{
+}
+
+/**
+ * @brief Construct a limb_vector of new_count limbs, all equal to value
+ * 
+ * @param new_count 
+ * @param value 
+ */
+limb_vector::limb_vector(size_t new_count, uint64_t value) 
+    : limb_vector()
+{
+    resize(new_count, value);
+}
+
+/**
+ * @brief copy constructor, allocates only if other doesn't fit in the inline buffer
+ * 
+ * @param other 
+ */
+limb_vector::limb_vector(const limb_vector& other) 
+    : limb_vector()
+{
+    reserve(other.count);
+    copy(other.limbs, other.limbs + other.count, limbs);
+    count = other.count;
+}
+
+/**
+ * @brief move constructor, steals the heap buffer of other if it has one
+ * 
+ * @param other 
+ */
+limb_vector::limb_vector(limb_vector&& other) noexcept 
+    : limb_vector()
+{
+    *this = move(other);
+}
+
+limb_vector::~limb_vector()
+{
+    release();
+}
+
+/**
+ * @brief copy assignment, reuses the current buffer when it is large enough
+ * 
+ * @param other 
+ * @return limb_vector& 
+ */
+limb_vector& limb_vector::operator=(const limb_vector& other)
+{
+    if (this != &other)
+    {
+        count = 0;
+        reserve(other.count);
+        copy(other.limbs, other.limbs + other.count, limbs);
+        count = other.count;
+    }
+    return *this;
+}
+
+/**
+ * @brief move assignment, steals the heap buffer of other if it has one
+ * 
+ * @param other 
+ * @return limb_vector& 
+ */
+limb_vector& limb_vector::operator=(limb_vector&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    if (other.is_inline())
+    {
+        // inline limbs can't be stolen, but copying them is cheap and keeps our heap buffer
+        copy(other.limbs, other.limbs + other.count, limbs);
+        count = other.count;
+    }
+    else
+    {
+        release();
+        limbs = other.limbs;
+        count = other.count;
+        cap = other.cap;
+        other.limbs = other.inline_limbs;
+        other.cap = LIMB_VECTOR_INLINE_CAPACITY;
+    }
+    other.count = 0;
+    return *this;
+}
+
+/**
+ * @brief frees the heap buffer (if any) and goes back to the inline buffer
+ * 
+ */
+void limb_vector::release()
+{
+    if (!is_inline())
+        delete[] limbs;
+    limbs = inline_limbs;
+    cap = LIMB_VECTOR_INLINE_CAPACITY;
+}
+
+/**
+ * @brief size, capacity and element access, same meaning as for std::vector
+ * 
+ */
+size_t limb_vector::size() const
+{
+    return count;
+}
+
+bool limb_vector::empty() const
+{
+    return count == 0;
+}
+
+size_t limb_vector::capacity() const
+{
+    return cap;
+}
+
+bool limb_vector::is_inline() const
+{
+    return limbs == inline_limbs;
+}
+
+uint64_t* limb_vector::data()
+{
+    return limbs;
+}
+
+const uint64_t* limb_vector::data() const
+{
+    return limbs;
+}
+
+uint64_t& limb_vector::operator[](size_t idx)
+{
+    return limbs[idx];
+}
+
+const uint64_t& limb_vector::operator[](size_t idx) const
+{
+    return limbs[idx];
+}
+
+uint64_t& limb_vector::back()
+{
+    return limbs[count - 1];
+}
+
+const uint64_t& limb_vector::back() const
+{
+    return limbs[count - 1];
+}
+
+uint64_t* limb_vector::begin()
+{
+    return limbs;
+}
+
+uint64_t* limb_vector::end()
+{
+    return limbs + count;
+}
+
+const uint64_t* limb_vector::begin() const
+{
+    return limbs;
+}
+
+const uint64_t* limb_vector::end() const
+{
+    return limbs + count;
+}
+
+/**
+ * @brief modifiers, same meaning as for std::vector
+ * 
+ */
+void limb_vector::push_back(uint64_t limb)
+{
+    if (count == cap)
+        reserve(2 * cap);
+    limbs[count++] = limb;
+}
+
+void limb_vector::pop_back()
+{
+    count--;
+}
+
+void limb_vector::clear()
+{
+    count = 0;
+}
+
+void limb_vector::resize(size_t new_count, uint64_t value)
+{
+    reserve(new_count);
+    if (new_count > count)
+        fill(limbs + count, limbs + new_count, value);
+    count = new_count;
+}
+
+/**
+ * @brief makes sure at least new_cap limbs fit without reallocating. 
+ * growth is geometric so that repeated push_back stays amortized O(1)
+ * 
+ * @param new_cap 
+ */
+void limb_vector::reserve(size_t new_cap)
+{
+    if (new_cap <= cap)
+        return;
+    new_cap = max(new_cap, cap + cap / 2);
+    uint64_t* new_limbs = new uint64_t[new_cap];
+    copy(limbs, limbs + count, new_limbs);
+    release();
+    limbs = new_limbs;
+    cap = new_cap;
+}
+
+/**
+ * @brief limb_vector == limb_vector, compares sizes then limbs
+ * 
+ * @return true if yes
+ * @return false if no
+ */
+bool operator==(const limb_vector& lhs, const limb_vector& rhs)
+{
+    return lhs.size() == rhs.size() and equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
 /**********************************************************************
 *************************** BIGINT CLASS ******************************
 **********************************************************************/
 
+class BigIntReciprocal;
+class BigIntMontgomery;
+class BigIntView;
+class BigIntParser;
+class BigIntMappedFile;
+
 class BigInt 
 {
     public:
@@ -62,18 +395,340 @@ class BigInt
         // overloaded BigInt *= string
         BigInt& operator*=(const string&);
 
+        // square of this BigInt, uses the dedicated squaring kernels
+        BigInt square() const;
+
+        // overloaded BigInt /= BigInt, the quotient is truncated toward zero
+        BigInt& operator/=(const BigInt&);
+        // overloaded BigInt /= 64-bit integer
+        BigInt& operator/=(const int64_t&);
+        // overloaded BigInt /= string
+        BigInt& operator/=(const string&);
+
+        // overloaded BigInt %= BigInt, the remainder has the sign of the dividend
+        BigInt& operator%=(const BigInt&);
+        // overloaded BigInt %= 64-bit integer
+        BigInt& operator%=(const int64_t&);
+        // overloaded BigInt %= string
+        BigInt& operator%=(const string&);
+
+        // overloaded BigInt /= and %= a divisor whose reciprocal is precomputed
+        BigInt& operator/=(const BigIntReciprocal&);
+        BigInt& operator%=(const BigIntReciprocal&);
+
+        // quotient and remainder of one division
+        friend tuple<BigInt, BigInt> divmod(const BigInt&, const BigInt&);
+        // quotient and remainder of one division by a divisor whose reciprocal is precomputed
+        friend tuple<BigInt, BigInt> divmod(const BigInt&, const BigIntReciprocal&);
+
+        // 64-bit integer - BigInt, negates rhs in place instead of copying it
+        friend BigInt operator-(const int64_t&, BigInt);
+
+        // base^exponent, 0^0 is 1
+        friend BigInt pow(const BigInt&, uint64_t);
+        // base^exponent mod modulus, in [0, |modulus|)
+        friend BigInt powmod(const BigInt&, const BigInt&, const BigInt&);
+        // base^exponent mod an odd modulus prepared for Montgomery multiplication
+        friend BigInt powmod(const BigInt&, const BigInt&, const BigIntMontgomery&);
+        // reduces BigInt objects in place by a modulus prepared for Barrett reduction
+        friend class BigIntModContext;
+
+        // floor of the square root, throws if the BigInt is negative
+        friend BigInt isqrt(const BigInt&);
+        // k-th root truncated toward zero, throws if k is zero or k is even and the BigInt 
+        // is negative
+        friend BigInt iroot(const BigInt&, uint64_t);
+        // true if the BigInt is the square of an integer
+        friend bool is_perfect_square(const BigInt&);
+
+        // greatest common divisor, always nonnegative
+        friend BigInt gcd(const BigInt&, const BigInt&);
+        friend BigInt gcd(const BigInt&, int64_t);
+        // g = gcd(a, b) and the cofactors s, t with s a + t b = g
+        friend tuple<BigInt, BigInt, BigInt> gcdext(const BigInt&, const BigInt&);
+        // product of a list of BigInt objects, by a balanced product tree
+        friend BigInt product(const vector<BigInt>&);
+        // n!, C(n, k) and the product of the primes up to n
+        friend BigInt factorial(uint64_t);
+        friend BigInt binomial(uint64_t, uint64_t);
+        friend BigInt primorial(uint64_t);
+
+        // parses a string of digits in a base from 2 to 36, letters of either case
+        friend BigInt from_string(const string&, int);
+
+        // arithmetic between views (and BigInt objects, converted to views) without copies
+        friend BigInt operator+(const BigIntView&, const BigIntView&);
+        friend BigInt operator-(const BigIntView&, const BigIntView&);
+        friend BigInt operator*(const BigIntView&, const BigIntView&);
+        // builds BigInt objects from views and from their serialized form
+        friend class BigIntView;
+        friend class BigIntParser;
+        friend BigInt deserialize(const uint8_t*, size_t);
+
+        // Baillie-PSW probable prime test, plus rounds Miller-Rabin tests to other bases
+        friend bool is_probable_prime(const BigInt&, size_t);
+        // the smallest prime greater than the BigInt
+        friend BigInt next_prime(const BigInt&);
+
         // get sign and value
         char get_sign() const;
         string get_abs_value() const;
+        // the value as a string of digits in a base from 2 to 36, letters are lowercase
+        string to_string(int base = 10) const;
+        // get the magnitude as little-endian 64-bit limbs
+        const limb_vector& get_limbs() const;
+
+        // maps a file written by save_to_file, read-only and without a copy
+        static BigIntMappedFile map_file(const string&);
+        // writes the serialized form to a file through a memory mapping
+        void save_to_file(const string&) const;
             
         // << stream
         friend ostream& operator<<(ostream&, const BigInt&);
 
     private:
-        string abs_value;
+        // magnitude, little-endian 64-bit limbs without leading zero limbs (zero has no limbs)
+        limb_vector limbs;
+        char sign;
+
+        // sets the magnitude from a value of at most two limbs (never allocates)
+        void assign_magnitude(uint64_t low, uint64_t high);
+        // in-place arithmetic with a signed single-limb magnitude, used by the fast paths of 
+        // the operators. they allocate only when the magnitude outgrows its capacity
+        void add_word(char other_sign, uint64_t other_abs);
+        void multiply_word(char other_sign, uint64_t other_abs);
+        // keeps the quotient, or the remainder if remainder is true. other_abs must not be zero
+        void divide_word(char other_sign, uint64_t other_abs, bool remainder);
+        // sets the magnitude and sign from a 64-bit integer
+        void assign_int64(const int64_t&);
+        // sets the magnitude and sign from a string of digits in a base, throws if it's not 
+        // an integer
+        void assign_string(const string&, unsigned);
+};
+
+/*
+ * A divisor prepared for dividing many dividends: its fixed-point reciprocal is computed 
+ * once by Newton iteration, after which each division costs two multiplications per block
+ * of the quotient instead of a full recursive division.
+ */
+class BigIntReciprocal
+{
+    public:
+        // prepares a divisor, throws if it's zero
+        BigIntReciprocal(const BigInt&);
+
+        // get the divisor
+        const BigInt& get_divisor() const;
+
+        friend tuple<BigInt, BigInt> divmod(const BigInt&, const BigIntReciprocal&);
+
+    private:
+        BigInt divisor;
+        // the divisor shifted left so that its top bit is set, and by how many bits
+        limb_vector normalized_divisor;
+        unsigned shift;
+        // floor((β^2n - 1) / normalized_divisor) - β^n, left empty for divisors too short to 
+        // benefit from it
+        limb_vector inverse;
+};
+
+/*
+ * An odd modulus prepared for Montgomery multiplication. Values are kept as x R mod m 
+ * with R = β^n (n the limb count of m), so a modular product is one multiplication and 
+ * one Montgomery reduction, which only multiplies and adds, instead of a division.
+ */
+class BigIntMontgomery
+{
+    public:
+        // prepares a modulus, throws if it's even (zero included). the sign is ignored
+        BigIntMontgomery(const BigInt&);
+
+        // get the modulus (always positive)
+        const BigInt& get_modulus() const;
+
+        friend BigInt powmod(const BigInt&, const BigInt&, const BigIntMontgomery&);
+
+    private:
+        BigInt modulus;
+        // -modulus^-1 mod β
+        uint64_t m_inverse;
+        // R^2 mod modulus, a Montgomery product with it converts into the Montgomery form
+        limb_vector r_squared;
+
+        // r = a b / R mod modulus, all of n limbs. r may alias a or b
+        void multiply(uint64_t* r, const uint64_t* a, const uint64_t* b, uint64_t* scratch) const;
+        // base^exponent mod modulus for a base already reduced
+        limb_vector power(const limb_vector& base, const limb_vector& exponent) const;
+};
+
+/*
+ * A modulus prepared for Barrett reduction: floor(β^2n / m) is computed once (n the limb 
+ * count of m), after which reducing a value of up to 2n limbs costs two multiplications 
+ * and a few subtractions, and no division.
+ */
+class BigIntModContext
+{
+    public:
+        // prepares a modulus, throws if it's zero. the sign is ignored
+        BigIntModContext(const BigInt&);
+
+        // get the modulus (always positive)
+        const BigInt& get_modulus() const;
+
+        // replaces x by x mod modulus, in [0, modulus)
+        void reduce(BigInt& x) const;
+
+    private:
+        BigInt modulus;
+        // floor(β^2n / modulus)
+        limb_vector mu;
+};
+
+/*
+ * A read-only BigInt that doesn't own its limbs: it points into a serialized buffer (see 
+ * deserialize_view) or at the limbs of a BigInt, so deserialized values are compared and 
+ * used in arithmetic without a copy. The limbs must outlive the view.
+ */
+class BigIntView
+{
+    public:
+        // a view of zero
+        BigIntView();
+        // a view of the limbs of a BigInt, which must not change while the view is used
+        BigIntView(const BigInt&);
+        // a view of count little-endian limbs without leading zero limbs, and a sign
+        BigIntView(const uint64_t*, size_t, char);
+
+        // get sign and limbs
+        char get_sign() const;
+        const uint64_t* get_limbs() const;
+        size_t size() const;
+
+        // an owning copy of the value
+        BigInt to_bigint() const;
+
+    private:
+        const uint64_t* limbs;
+        size_t count;
         char sign;
 };
 
+/**
+ * @brief a power b^(c 2^k) of the radix conversion tree, prepared for division like a 
+ * BigIntReciprocal
+ * 
+ */
+struct radix_power
+{
+    limb_vector power;
+    // the power shifted left so that its top bit is set, and by how many bits
+    limb_vector normalized;
+    unsigned shift;
+    // reciprocal of normalized, left empty below newton_threshold limbs
+    limb_vector inverse;
+};
+
+/*
+ * The powers of one base used by one conversion. Powers up to radix_cache_limbs limbs 
+ * come from a cache shared by all conversions, larger ones are computed by the table 
+ * and freed with it.
+ */
+class radix_powers
+{
+    public:
+        radix_powers(unsigned);
+        // the power b^(c 2^k), prepared for division if divisor is true
+        const radix_power& get(size_t, bool);
+        unsigned get_base() const;
+
+    private:
+        unsigned base;
+        // number of cached levels, SIZE_MAX until a larger one is asked for
+        size_t cached_levels;
+        // levels cached_levels and up
+        deque<radix_power> large;
+};
+
+/*
+ * A push parser for integers too long to keep as text: the characters are fed in pieces 
+ * of any size, and each block of digits is converted as soon as it is complete. Blocks 
+ * are merged pairwise as they arrive, like the carries of a binary counter, which builds 
+ * the divide-and-conquer conversion tree from the bottom up. Only the converted parts, 
+ * which add up to the size of the result, and one block of text are kept.
+ */
+class BigIntParser
+{
+    public:
+        // a parser of digits in a base from 2 to 36, throws if the base is out of range
+        BigIntParser(int base = 10);
+
+        // parses the next characters: whitespace, a sign, digits, then only whitespace. 
+        // throws if they can't continue an integer, which digits only show once their 
+        // block is converted (by finish at the latest)
+        void feed(const char*, size_t);
+        // the integer fed so far, after which the parser starts over. throws if no digit 
+        // was fed
+        BigInt finish();
+
+    private:
+        unsigned base;
+        // a block is radix_chunk_of(base).digits 2^block_level digits
+        size_t block_level;
+        size_t block_digits;
+        // digits of the block being filled
+        string pending;
+        // converted parts, most significant first. part i has block_digits 2^levels[i] digits
+        vector<limb_vector> parts;
+        vector<size_t> levels;
+        // a sign or a digit was fed, a digit was fed, a nonzero digit was fed, and 
+        // whitespace ended the integer
+        bool started;
+        bool negative;
+        bool any_digit;
+        bool significant;
+        bool ended;
+
+        // converts digits, up to a block of them, and appends them to the parts
+        void convert(const char*, size_t);
+        // high b^digits + low, as limbs. low has block_digits 2^level digits, or any number 
+        // of digits if level is SIZE_MAX
+        limb_vector combine(const limb_vector&, const limb_vector&, size_t, size_t);
+        // powers of the base the parts are combined with
+        radix_powers powers;
+};
+
+/*
+ * A BigInt saved by save_to_file and mapped into memory by BigInt::map_file: the pages of 
+ * the file are the limbs, read through a BigIntView with no parsing and no copy, and only 
+ * loaded as they are touched. The mapping is private and read-only, so the file never 
+ * changes; to_bigint copies the value out for arithmetic that modifies it.
+ */
+class BigIntMappedFile
+{
+    public:
+        // maps a file, throws if it can't be opened or isn't a serialized BigInt
+        BigIntMappedFile(const string&);
+        // the mapping moves, it can't be copied
+        BigIntMappedFile(BigIntMappedFile&&) noexcept;
+        BigIntMappedFile& operator=(BigIntMappedFile&&) noexcept;
+        BigIntMappedFile(const BigIntMappedFile&) = delete;
+        BigIntMappedFile& operator=(const BigIntMappedFile&) = delete;
+        ~BigIntMappedFile();
+
+        // the value, valid while the mapping lives
+        const BigIntView& view() const;
+        // an owning copy of the value
+        BigInt to_bigint() const;
+
+    private:
+        void* mapping;
+        size_t length;
+        BigIntView value;
+
+        // unmaps the file if it is mapped
+        void release();
+};
+
 // overloaded BigInt + BigInt
 BigInt operator+(BigInt lhs, const BigInt& rhs);
 
@@ -84,7 +739,7 @@ BigInt operator+(const BigInt& lhs, const string& rhs);
 BigInt operator+(const string& lhs, const BigInt& rhs);
 
 // overloaded BigInt + 64-bit integer
-BigInt operator+(const BigInt& lhs, const int64_t& rhs);
+BigInt operator+(BigInt lhs, const int64_t& rhs);
 
 // overloaded 64-bit integer + BigInt
 BigInt operator+(const int64_t& lhs, BigInt rhs);
@@ -99,7 +754,7 @@ BigInt operator-(const BigInt& lhs, const string& rhs);
 BigInt operator-(const string& lhs, const BigInt& rhs);
 
 // overloaded BigInt - 64-bit integer
-BigInt operator-(const BigInt& lhs, const int64_t& rhs);
+BigInt operator-(BigInt lhs, const int64_t& rhs);
 
 // overloaded 64-bit integer - BigInt
 BigInt operator-(const int64_t& lhs, BigInt rhs);
@@ -114,11 +769,100 @@ BigInt operator*(const BigInt& lhs, const string& rhs);
 BigInt operator*(const string& lhs, const BigInt& rhs);
 
 // overloaded BigInt * 64-bit integer
-BigInt operator*(const BigInt& lhs, const int64_t& rhs);
+BigInt operator*(BigInt lhs, const int64_t& rhs);
 
 // overloaded 64-bit integer * BigInt
 BigInt operator*(const int64_t& lhs, BigInt rhs);
 
+// overloaded BigInt / BigInt
+BigInt operator/(BigInt lhs, const BigInt& rhs);
+
+// overloaded BigInt / string
+BigInt operator/(const BigInt& lhs, const string& rhs);
+
+// overloaded string / BigInt
+BigInt operator/(const string& lhs, const BigInt& rhs);
+
+// overloaded BigInt / 64-bit integer
+BigInt operator/(BigInt lhs, const int64_t& rhs);
+
+// overloaded 64-bit integer / BigInt
+BigInt operator/(const int64_t& lhs, BigInt rhs);
+
+// overloaded BigInt % BigInt
+BigInt operator%(BigInt lhs, const BigInt& rhs);
+
+// overloaded BigInt % string
+BigInt operator%(const BigInt& lhs, const string& rhs);
+
+// overloaded string % BigInt
+BigInt operator%(const string& lhs, const BigInt& rhs);
+
+// overloaded BigInt % 64-bit integer
+BigInt operator%(const BigInt& lhs, const int64_t& rhs);
+
+// overloaded 64-bit integer % BigInt
+BigInt operator%(const int64_t& lhs, BigInt rhs);
+
+// overloaded BigInt / BigIntReciprocal
+BigInt operator/(BigInt lhs, const BigIntReciprocal& rhs);
+
+// overloaded BigInt % BigIntReciprocal
+BigInt operator%(BigInt lhs, const BigIntReciprocal& rhs);
+
+// greatest common divisor of a 64-bit integer and a BigInt, always nonnegative
+BigInt gcd(int64_t a, const BigInt& b);
+
+// least common multiple, always nonnegative
+BigInt lcm(const BigInt& a, const BigInt& b);
+
+// least common multiple of a BigInt and a 64-bit integer, always nonnegative
+BigInt lcm(const BigInt& a, int64_t b);
+
+// least common multiple of a 64-bit integer and a BigInt, always nonnegative
+BigInt lcm(int64_t a, const BigInt& b);
+
+// inverse of a modulo m, in [0, |m|), throws if it doesn't exist
+BigInt invert(const BigInt& a, const BigInt& modulus);
+
+// Baillie-PSW probable prime test, plus rounds Miller-Rabin tests to other bases
+bool is_probable_prime(const BigInt& n, size_t rounds = 0);
+
+// parses a string of digits in a base from 2 to 36, letters of either case
+BigInt from_string(const string& str, int base);
+
+// number of bytes of the serialized form
+size_t serialized_size(const BigIntView& x);
+
+// writes the serialized form into a buffer, returns its size. throws if it doesn't fit
+size_t serialize(const BigIntView& x, uint8_t* buffer, size_t capacity);
+
+// reads a serialized value into a new BigInt, throws if the buffer isn't a valid one
+BigInt deserialize(const uint8_t* buffer, size_t size);
+
+// reads a serialized value as a view of the limbs inside the buffer, throws if the buffer 
+// isn't a valid one or its limbs aren't 8-byte aligned
+BigIntView deserialize_view(const uint8_t* buffer, size_t size);
+
+// overloaded view + view, view - view, view * view
+BigInt operator+(const BigIntView& lhs, const BigIntView& rhs);
+BigInt operator-(const BigIntView& lhs, const BigIntView& rhs);
+BigInt operator*(const BigIntView& lhs, const BigIntView& rhs);
+
+// overloaded comparisons between views
+bool operator==(const BigIntView& lhs, const BigIntView& rhs);
+bool operator!=(const BigIntView& lhs, const BigIntView& rhs);
+bool operator<(const BigIntView& lhs, const BigIntView& rhs);
+bool operator>(const BigIntView& lhs, const BigIntView& rhs);
+bool operator<=(const BigIntView& lhs, const BigIntView& rhs);
+bool operator>=(const BigIntView& lhs, const BigIntView& rhs);
+
+// overloaded << for views
+ostream& operator<<(ostream& out, const BigIntView& x);
+
+// overloaded >>, reads a sign and digits in the base of the stream (dec, hex or oct)
+istream& operator>>(istream& in, BigInt& x);
+
 // overloaded BigInt == BigInt
 bool operator==(const BigInt& lhs, const BigInt& rhs);
 
@@ -210,724 +954,6669 @@ bool operator<=(const int64_t& lhs, const BigInt& rhs);
 bool operator<=(const BigInt& lhs, const int64_t& rhs);
 
 /**********************************************************************
-*********************** AUXILIARY FUNCTIONS ***************************
+********************* VECTOR ADD AND SUBTRACT *************************
 **********************************************************************/
 
+/*
+ * Add and subtract kernels for limbs_add_n and limbs_sub_n. The vector kernels add 
+ * (or subtract) all lanes at once, then resolve the carries of a whole block with a few 
+ * scalar operations on lane masks: lane i generates a carry if its sum wrapped around 
+ * (s < a), and propagates an incoming carry if its sum is all ones. With G and P those 
+ * masks and c the carry into the block, ((G << 1 | c) + P) ^ P marks the lanes that 
+ * receive a carry and the bit above the block is the carry out, so the serial chain is 
+ * one add per block instead of one per limb. Subtraction is the same with borrows: 
+ * a lane generates one if a < b and propagates one if its difference is zero.
+ * 
+ * The kernel is chosen by CPUID the first time it's needed. Every kernel takes a carry 
+ * in and returns the carry out, the scalar ones also finish the tails of the vector ones.
+ */
+
+// operand size (in limbs) from which limbs_add_n and limbs_sub_n use the vector kernels
+size_t simd_add_threshold = 16;
+
+typedef uint64_t (*limbs_carry_kernel)(uint64_t*, const uint64_t*, const uint64_t*, 
+                                       size_t, uint64_t);
+
 /**
- * @brief is_number checks if a string can be interpreted as an integer
+ * @brief r = a + b + carry, all of n limbs, one limb at a time
  * 
- * @param str the input string
- * @return true if the string can be seen as an integer
- * @return false else. e.g. "23451515gsgas51235124asfq" can't be seen as an integer
+ * @return uint64_t:: carry out (0 or 1)
  */
-bool is_number(const string& str) 
+uint64_t limbs_add_nc(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, 
+                      uint64_t carry)
 {
-    int64_t ascii_0 = int('0');
-    int64_t ascii_9 = int('9');
-    for(size_t i = 0; i < str.size(); i++)
+    for (size_t i = 0; i < n; i++)
     {
-        if(str[i] < ascii_0 or str[i] > ascii_9)
-            return false;
+        uint64_t sum_i = a[i] + carry;
+        carry = sum_i < carry;
+        sum_i += b[i];
+        carry += sum_i < b[i];
+        r[i] = sum_i;
     }
-    return true;
+    return carry;
 }
 
 /**
- * @brief remove_left_zeros removes zeros before a number starts from it's string representation
+ * @brief r = a - b - borrow, all of n limbs, one limb at a time
  * 
- * @param str the input string
+ * @return uint64_t:: borrow out (0 or 1)
  */
-string remove_left_zeros(string& str) 
+uint64_t limbs_sub_nc(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, 
+                      uint64_t borrow)
 {
-    char zero = str[0];
-    size_t idx = 0;
-    while (zero == '0') 
+    for (size_t i = 0; i < n; i++)
     {
-        idx++;
-        zero = str[idx];
+        uint64_t sub_i = a[i] - b[i];
+        uint64_t next_borrow = a[i] < b[i];
+        next_borrow += sub_i < borrow;
+        r[i] = sub_i - borrow;
+        borrow = next_borrow;
     }
-    str = str.substr(idx);
-    if(str.size() == 0)
-        str = "0";
-        
-    return str;
+    return borrow;
 }
 
+#ifdef BIGINT_X86_DISPATCH
+
 /**
- * @brief sum two large numbers represented as strings, without signs
+ * @brief lanes of a 4-lane vector whose bit is set in mask become all ones, the others zero
  * 
- * @param str1 
- * @param str2 
- * @return string:: sum result
+ * @param mask 4-bit lane mask
+ * @return __m256i 
  */
-string positive_sum(const string& str1, const string& str2)
+__attribute__((target("avx2")))
+inline __m256i avx2_lane_mask(unsigned mask)
 {
-    // create a vector and push back the first input as in int in reverse (for easier addition)
-    vector<int64_t> str1_v;
-    for (size_t i = str1.size(); i >= 1; i--)
-        str1_v.push_back(str1[i - 1] - '0');
-
-    // create a vector and push back the second input as in int in reverse (for easier addition)
-    vector<int64_t> str2_v;
-    for (size_t i = str2.size(); i >= 1; i--)
-        str2_v.push_back(str2[i - 1] - '0');
-
-    // add 0 padding to the smaller one
-    while (str1_v.size() < str2_v.size()) 
-        str1_v.push_back(0);
-    while (str2_v.size() < str1_v.size()) 
-        str2_v.push_back(0);
+    const __m256i lane_bits = _mm256_set_epi64x(8, 4, 2, 1);
+    __m256i bits = _mm256_and_si256(_mm256_set1_epi64x(mask), lane_bits);
+    return _mm256_cmpeq_epi64(bits, lane_bits);
+}
 
-    string sum;
-    int64_t carry = 0;
-    // addition loop
-    for (uint64_t i = 0; i < str1_v.size(); i++) 
-    {
-        int64_t sum_i = str1_v[i] + str2_v[i] + carry;
-        sum += to_string(sum_i % 10);
-        carry = sum_i / 10;
+/**
+ * @brief r = a + b + carry, all of n limbs, 8 limbs (two AVX2 vectors) per carry resolve
+ * 
+ * @return uint64_t:: carry out (0 or 1)
+ */
+__attribute__((target("avx2")))
+uint64_t limbs_add_nc_avx2(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, 
+                           uint64_t carry)
+{
+    // AVX2 only compares signed lanes, flipping the sign bits makes it unsigned
+    const __m256i sign_bit = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i a0 = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i a1 = _mm256_loadu_si256((const __m256i*)(a + i + 4));
+        __m256i s0 = _mm256_add_epi64(a0, _mm256_loadu_si256((const __m256i*)(b + i)));
+        __m256i s1 = _mm256_add_epi64(a1, _mm256_loadu_si256((const __m256i*)(b + i + 4)));
+
+        __m256i g0 = _mm256_cmpgt_epi64(_mm256_xor_si256(a0, sign_bit), 
+                                        _mm256_xor_si256(s0, sign_bit));
+        __m256i g1 = _mm256_cmpgt_epi64(_mm256_xor_si256(a1, sign_bit), 
+                                        _mm256_xor_si256(s1, sign_bit));
+        unsigned generate = _mm256_movemask_pd(_mm256_castsi256_pd(g0)) 
+                            | _mm256_movemask_pd(_mm256_castsi256_pd(g1)) << 4;
+        unsigned propagate = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(s0, ones))) 
+                             | _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(s1, ones))) << 4;
+
+        unsigned t = ((generate << 1) | carry) + propagate;
+        unsigned incoming = (t ^ propagate) & 0xFF;
+        carry = t >> 8;
+
+        // subtracting an all-ones lane adds the incoming carry
+        _mm256_storeu_si256((__m256i*)(r + i), _mm256_sub_epi64(s0, avx2_lane_mask(incoming & 0xF)));
+        _mm256_storeu_si256((__m256i*)(r + i + 4), _mm256_sub_epi64(s1, avx2_lane_mask(incoming >> 4)));
+    }
+    return limbs_add_nc(r + i, a + i, b + i, n - i, carry);
+}
+
+/**
+ * @brief r = a - b - borrow, all of n limbs, 8 limbs (two AVX2 vectors) per borrow resolve
+ * 
+ * @return uint64_t:: borrow out (0 or 1)
+ */
+__attribute__((target("avx2")))
+uint64_t limbs_sub_nc_avx2(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, 
+                           uint64_t borrow)
+{
+    const __m256i sign_bit = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i a0 = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i a1 = _mm256_loadu_si256((const __m256i*)(a + i + 4));
+        __m256i b0 = _mm256_loadu_si256((const __m256i*)(b + i));
+        __m256i b1 = _mm256_loadu_si256((const __m256i*)(b + i + 4));
+        __m256i d0 = _mm256_sub_epi64(a0, b0);
+        __m256i d1 = _mm256_sub_epi64(a1, b1);
+
+        __m256i g0 = _mm256_cmpgt_epi64(_mm256_xor_si256(b0, sign_bit), 
+                                        _mm256_xor_si256(a0, sign_bit));
+        __m256i g1 = _mm256_cmpgt_epi64(_mm256_xor_si256(b1, sign_bit), 
+                                        _mm256_xor_si256(a1, sign_bit));
+        unsigned generate = _mm256_movemask_pd(_mm256_castsi256_pd(g0)) 
+                            | _mm256_movemask_pd(_mm256_castsi256_pd(g1)) << 4;
+        unsigned propagate = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(d0, zero))) 
+                             | _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(d1, zero))) << 4;
+
+        unsigned t = ((generate << 1) | borrow) + propagate;
+        unsigned incoming = (t ^ propagate) & 0xFF;
+        borrow = t >> 8;
+
+        // adding an all-ones lane subtracts the incoming borrow
+        _mm256_storeu_si256((__m256i*)(r + i), _mm256_add_epi64(d0, avx2_lane_mask(incoming & 0xF)));
+        _mm256_storeu_si256((__m256i*)(r + i + 4), _mm256_add_epi64(d1, avx2_lane_mask(incoming >> 4)));
+    }
+    return limbs_sub_nc(r + i, a + i, b + i, n - i, borrow);
+}
+
+/**
+ * @brief r = a + b + carry, all of n limbs, 16 limbs (two AVX-512 vectors) per carry 
+ * resolve. the lane masks come straight out of the compares
+ * 
+ * @return uint64_t:: carry out (0 or 1)
+ */
+__attribute__((target("avx512f")))
+uint64_t limbs_add_nc_avx512(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, 
+                             uint64_t carry)
+{
+    const __m512i ones = _mm512_set1_epi64(-1);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512i a0 = _mm512_loadu_si512(a + i);
+        __m512i a1 = _mm512_loadu_si512(a + i + 8);
+        __m512i s0 = _mm512_add_epi64(a0, _mm512_loadu_si512(b + i));
+        __m512i s1 = _mm512_add_epi64(a1, _mm512_loadu_si512(b + i + 8));
+
+        unsigned generate = _mm512_cmplt_epu64_mask(s0, a0) 
+                            | (unsigned)_mm512_cmplt_epu64_mask(s1, a1) << 8;
+        unsigned propagate = _mm512_cmpeq_epi64_mask(s0, ones) 
+                             | (unsigned)_mm512_cmpeq_epi64_mask(s1, ones) << 8;
+
+        unsigned t = ((generate << 1) | carry) + propagate;
+        unsigned incoming = t ^ propagate;
+        carry = (t >> 16) & 1;
+
+        _mm512_storeu_si512(r + i, _mm512_mask_sub_epi64(s0, (__mmask8)incoming, s0, ones));
+        _mm512_storeu_si512(r + i + 8, _mm512_mask_sub_epi64(s1, (__mmask8)(incoming >> 8), s1, ones));
+    }
+    return limbs_add_nc(r + i, a + i, b + i, n - i, carry);
+}
+
+/**
+ * @brief r = a - b - borrow, all of n limbs, 16 limbs (two AVX-512 vectors) per borrow 
+ * resolve
+ * 
+ * @return uint64_t:: borrow out (0 or 1)
+ */
+__attribute__((target("avx512f")))
+uint64_t limbs_sub_nc_avx512(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, 
+                             uint64_t borrow)
+{
+    const __m512i ones = _mm512_set1_epi64(-1);
+    const __m512i zero = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512i a0 = _mm512_loadu_si512(a + i);
+        __m512i a1 = _mm512_loadu_si512(a + i + 8);
+        __m512i b0 = _mm512_loadu_si512(b + i);
+        __m512i b1 = _mm512_loadu_si512(b + i + 8);
+        __m512i d0 = _mm512_sub_epi64(a0, b0);
+        __m512i d1 = _mm512_sub_epi64(a1, b1);
+
+        unsigned generate = _mm512_cmplt_epu64_mask(a0, b0) 
+                            | (unsigned)_mm512_cmplt_epu64_mask(a1, b1) << 8;
+        unsigned propagate = _mm512_cmpeq_epi64_mask(d0, zero) 
+                             | (unsigned)_mm512_cmpeq_epi64_mask(d1, zero) << 8;
+
+        unsigned t = ((generate << 1) | borrow) + propagate;
+        unsigned incoming = t ^ propagate;
+        borrow = (t >> 16) & 1;
+
+        _mm512_storeu_si512(r + i, _mm512_mask_add_epi64(d0, (__mmask8)incoming, d0, ones));
+        _mm512_storeu_si512(r + i + 8, _mm512_mask_add_epi64(d1, (__mmask8)(incoming >> 8), d1, ones));
+    }
+    return limbs_sub_nc(r + i, a + i, b + i, n - i, borrow);
+}
+
+#endif
+
+/**
+ * @brief picks the fastest add kernel this CPU supports
+ * 
+ * @return limbs_carry_kernel 
+ */
+limbs_carry_kernel select_limbs_add_nc()
+{
+#ifdef BIGINT_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return limbs_add_nc_avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return limbs_add_nc_avx2;
+#endif
+    return limbs_add_nc;
+}
+
+/**
+ * @brief picks the fastest subtract kernel this CPU supports
+ * 
+ * @return limbs_carry_kernel 
+ */
+limbs_carry_kernel select_limbs_sub_nc()
+{
+#ifdef BIGINT_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return limbs_sub_nc_avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return limbs_sub_nc_avx2;
+#endif
+    return limbs_sub_nc;
+}
+
+/**********************************************************************
+*********************** MULX AND ADX MULTIPLY *************************
+**********************************************************************/
+
+/*
+ * Row kernels for limbs_mul_1, limbs_addmul_1 and limbs_submul_1, which every 
+ * multiplication and division tier ends up in through the basecases. The portable ones 
+ * use unsigned __int128. On x86-64 CPUs with BMI2 and ADX the MULX versions are used 
+ * instead: MULX multiplies without touching the flags, so ADCX (carry flag) can chain 
+ * the high half of one product into the next low half while ADOX (overflow flag) adds 
+ * the limbs of r in a second, independent carry chain. The loops move with LEA and exit 
+ * with JRCXZ, which leave both flags alone.
+ */
+
+// the row kernels picked by CPUID the first time one of them is needed
+struct multiply_kernels
+{
+    uint64_t (*mul_1)(uint64_t*, const uint64_t*, size_t, uint64_t);
+    uint64_t (*addmul_1)(uint64_t*, const uint64_t*, size_t, uint64_t);
+    uint64_t (*submul_1)(uint64_t*, const uint64_t*, size_t, uint64_t);
+};
+
+/**
+ * @brief r = a * b where a has n limbs and b is a single limb, with unsigned __int128
+ * 
+ * @return uint64_t:: the limb carried out of the top
+ */
+uint64_t limbs_mul_1_generic(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        unsigned __int128 t = (unsigned __int128)a[i] * b + carry;
+        r[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+    return carry;
+}
+
+/**
+ * @brief r += a * b where a has n limbs and b is a single limb, with unsigned __int128
+ * 
+ * @return uint64_t:: the limb carried out of the top
+ */
+uint64_t limbs_addmul_1_generic(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        unsigned __int128 t = (unsigned __int128)a[i] * b + r[i] + carry;
+        r[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+    return carry;
+}
+
+/**
+ * @brief r -= a * b where a has n limbs and b is a single limb, with unsigned __int128
+ * 
+ * @return uint64_t:: the limb borrowed from above the top
+ */
+uint64_t limbs_submul_1_generic(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        unsigned __int128 t = (unsigned __int128)a[i] * b + borrow;
+        uint64_t low = (uint64_t)t;
+        borrow = (uint64_t)(t >> 64) + (r[i] < low);
+        r[i] -= low;
+    }
+    return borrow;
+}
+
+#ifdef BIGINT_X86_DISPATCH
+
+/**
+ * @brief r = a * b where a has n limbs and b is a single limb, 4 limbs per iteration 
+ * with MULX and one ADCX carry chain
+ * 
+ * @return uint64_t:: the limb carried out of the top
+ */
+__attribute__((target("bmi2,adx")))
+uint64_t limbs_mul_1_mulx(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    uint64_t carry = 0, low, high;
+    size_t blocks = n / 4;
+    __asm__(
+        "xor %k[low], %k[low]\n\t"
+        "jrcxz 2f\n"
+        "1:\n\t"
+        "mulx (%[a]), %[low], %[high]\n\t"
+        "adcx %[carry], %[low]\n\t"
+        "mov %[low], (%[r])\n\t"
+        "mulx 8(%[a]), %[low], %[carry]\n\t"
+        "adcx %[high], %[low]\n\t"
+        "mov %[low], 8(%[r])\n\t"
+        "mulx 16(%[a]), %[low], %[high]\n\t"
+        "adcx %[carry], %[low]\n\t"
+        "mov %[low], 16(%[r])\n\t"
+        "mulx 24(%[a]), %[low], %[carry]\n\t"
+        "adcx %[high], %[low]\n\t"
+        "mov %[low], 24(%[r])\n\t"
+        "lea 32(%[a]), %[a]\n\t"
+        "lea 32(%[r]), %[r]\n\t"
+        "lea -1(%[blocks]), %[blocks]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n"
+        "2:\n\t"
+        "mov %[rest], %[blocks]\n\t"
+        "jrcxz 4f\n"
+        "3:\n\t"
+        "mulx (%[a]), %[low], %[high]\n\t"
+        "adcx %[carry], %[low]\n\t"
+        "mov %[low], (%[r])\n\t"
+        "mov %[high], %[carry]\n\t"
+        "lea 8(%[a]), %[a]\n\t"
+        "lea 8(%[r]), %[r]\n\t"
+        "lea -1(%[blocks]), %[blocks]\n\t"
+        "jrcxz 4f\n\t"
+        "jmp 3b\n"
+        "4:\n\t"
+        "mov $0, %k[low]\n\t"
+        "adcx %[low], %[carry]\n\t"
+        : [r] "+r"(r), [a] "+r"(a), [carry] "+r"(carry), [low] "=&r"(low), [high] "=&r"(high),
+          [blocks] "+c"(blocks)
+        : [rest] "r"(n % 4), "d"(b)
+        : "cc", "memory");
+    return carry;
+}
+
+/**
+ * @brief r += a * b where a has n limbs and b is a single limb, 4 limbs per iteration. 
+ * ADCX chains the product halves and ADOX adds r
+ * 
+ * @return uint64_t:: the limb carried out of the top
+ */
+__attribute__((target("bmi2,adx")))
+uint64_t limbs_addmul_1_mulx(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    uint64_t carry = 0, low, high;
+    size_t blocks = n / 4;
+    __asm__(
+        "xor %k[low], %k[low]\n\t"
+        "jrcxz 2f\n"
+        "1:\n\t"
+        "mulx (%[a]), %[low], %[high]\n\t"
+        "adcx %[carry], %[low]\n\t"
+        "adox (%[r]), %[low]\n\t"
+        "mov %[low], (%[r])\n\t"
+        "mulx 8(%[a]), %[low], %[carry]\n\t"
+        "adcx %[high], %[low]\n\t"
+        "adox 8(%[r]), %[low]\n\t"
+        "mov %[low], 8(%[r])\n\t"
+        "mulx 16(%[a]), %[low], %[high]\n\t"
+        "adcx %[carry], %[low]\n\t"
+        "adox 16(%[r]), %[low]\n\t"
+        "mov %[low], 16(%[r])\n\t"
+        "mulx 24(%[a]), %[low], %[carry]\n\t"
+        "adcx %[high], %[low]\n\t"
+        "adox 24(%[r]), %[low]\n\t"
+        "mov %[low], 24(%[r])\n\t"
+        "lea 32(%[a]), %[a]\n\t"
+        "lea 32(%[r]), %[r]\n\t"
+        "lea -1(%[blocks]), %[blocks]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n"
+        "2:\n\t"
+        "mov %[rest], %[blocks]\n\t"
+        "jrcxz 4f\n"
+        "3:\n\t"
+        "mulx (%[a]), %[low], %[high]\n\t"
+        "adcx %[carry], %[low]\n\t"
+        "adox (%[r]), %[low]\n\t"
+        "mov %[low], (%[r])\n\t"
+        "mov %[high], %[carry]\n\t"
+        "lea 8(%[a]), %[a]\n\t"
+        "lea 8(%[r]), %[r]\n\t"
+        "lea -1(%[blocks]), %[blocks]\n\t"
+        "jrcxz 4f\n\t"
+        "jmp 3b\n"
+        "4:\n\t"
+        // both chains end in the top limb, which can't overflow
+        "mov $0, %k[low]\n\t"
+        "adcx %[low], %[carry]\n\t"
+        "adox %[low], %[carry]\n\t"
+        : [r] "+r"(r), [a] "+r"(a), [carry] "+r"(carry), [low] "=&r"(low), [high] "=&r"(high),
+          [blocks] "+c"(blocks)
+        : [rest] "r"(n % 4), "d"(b)
+        : "cc", "memory");
+    return carry;
+}
+
+/**
+ * @brief r -= a * b where a has n limbs and b is a single limb, 4 limbs per iteration. 
+ * ADCX chains the product halves and ADOX adds the complemented product to r, so r - t 
+ * is computed as r + ~t + 1 with the overflow flag starting at 1
+ * 
+ * @return uint64_t:: the limb borrowed from above the top
+ */
+__attribute__((target("bmi2,adx")))
+uint64_t limbs_submul_1_mulx(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    uint64_t carry = 0, low, high;
+    size_t blocks = n / 4;
+    __asm__(
+        // INT32_MAX + 1 sets the overflow flag and clears the carry flag
+        "mov $0x7fffffff, %k[low]\n\t"
+        "add $1, %k[low]\n\t"
+        "jrcxz 2f\n"
+        "1:\n\t"
+        "mulx (%[a]), %[low], %[high]\n\t"
+        "adcx %[carry], %[low]\n\t"
+        "not %[low]\n\t"
+        "adox (%[r]), %[low]\n\t"
+        "mov %[low], (%[r])\n\t"
+        "mulx 8(%[a]), %[low], %[carry]\n\t"
+        "adcx %[high], %[low]\n\t"
+        "not %[low]\n\t"
+        "adox 8(%[r]), %[low]\n\t"
+        "mov %[low], 8(%[r])\n\t"
+        "mulx 16(%[a]), %[low], %[high]\n\t"
+        "adcx %[carry], %[low]\n\t"
+        "not %[low]\n\t"
+        "adox 16(%[r]), %[low]\n\t"
+        "mov %[low], 16(%[r])\n\t"
+        "mulx 24(%[a]), %[low], %[carry]\n\t"
+        "adcx %[high], %[low]\n\t"
+        "not %[low]\n\t"
+        "adox 24(%[r]), %[low]\n\t"
+        "mov %[low], 24(%[r])\n\t"
+        "lea 32(%[a]), %[a]\n\t"
+        "lea 32(%[r]), %[r]\n\t"
+        "lea -1(%[blocks]), %[blocks]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n"
+        "2:\n\t"
+        "mov %[rest], %[blocks]\n\t"
+        "jrcxz 4f\n"
+        "3:\n\t"
+        "mulx (%[a]), %[low], %[high]\n\t"
+        "adcx %[carry], %[low]\n\t"
+        "not %[low]\n\t"
+        "adox (%[r]), %[low]\n\t"
+        "mov %[low], (%[r])\n\t"
+        "mov %[high], %[carry]\n\t"
+        "lea 8(%[a]), %[a]\n\t"
+        "lea 8(%[r]), %[r]\n\t"
+        "lea -1(%[blocks]), %[blocks]\n\t"
+        "jrcxz 4f\n\t"
+        "jmp 3b\n"
+        "4:\n\t"
+        // the borrow is the top product limb plus its carry, plus 1 unless r + ~t + 1 
+        // carried out (the overflow flag is left in low)
+        "mov $0, %k[low]\n\t"
+        "adcx %[low], %[carry]\n\t"
+        "seto %b[low]\n\t"
+        : [r] "+r"(r), [a] "+r"(a), [carry] "+r"(carry), [low] "=&r"(low), [high] "=&r"(high),
+          [blocks] "+c"(blocks)
+        : [rest] "r"(n % 4), "d"(b)
+        : "cc", "memory");
+    return carry + 1 - low;
+}
+
+#endif
+
+/**
+ * @brief picks the fastest row kernels this CPU supports
+ * 
+ * @return const multiply_kernels& 
+ */
+const multiply_kernels& selected_multiply_kernels()
+{
+    static const multiply_kernels generic = {limbs_mul_1_generic, limbs_addmul_1_generic, 
+                                             limbs_submul_1_generic};
+#ifdef BIGINT_X86_DISPATCH
+    static const multiply_kernels mulx = {limbs_mul_1_mulx, limbs_addmul_1_mulx, 
+                                          limbs_submul_1_mulx};
+    static const bool use_mulx = (__builtin_cpu_init(), __builtin_cpu_supports("bmi2") 
+                                  and __builtin_cpu_supports("adx"));
+    if (use_mulx)
+        return mulx;
+#endif
+    return generic;
+}
+
+/**********************************************************************
+**************************** LIMB KERNELS *****************************
+**********************************************************************/
+
+/*
+ * Low-level routines working on raw little-endian limb arrays. They don't allocate;
+ * the caller provides the result and scratch space. r may alias a (in place) in the
+ * add and subtract routines, but not in the multiplication routines.
+ */
+
+// operand size (in limbs) from which operator*= switches from schoolbook to Karatsuba
+size_t karatsuba_threshold = 32;
+
+/**
+ * @brief r = a + b, all of n limbs. long operands go to the vector kernel picked for 
+ * this CPU, short ones stay on the scalar loop
+ * 
+ * @return uint64_t:: carry out (0 or 1)
+ */
+uint64_t limbs_add_n(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n)
+{
+    if (n < simd_add_threshold)
+        return limbs_add_nc(r, a, b, n, 0);
+    static const limbs_carry_kernel kernel = select_limbs_add_nc();
+    return kernel(r, a, b, n, 0);
+}
+
+/**
+ * @brief r = a + b where a has an limbs, b has bn limbs and an >= bn. r has an limbs. 
+ * above bn the carry stops as soon as it can, so in place (r == a) the untouched high 
+ * limbs of a are not even read
+ * 
+ * @return uint64_t:: carry out (0 or 1)
+ */
+uint64_t limbs_add(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn)
+{
+    uint64_t carry = limbs_add_n(r, a, b, bn);
+    for (size_t i = bn; i < an; i++)
+    {
+        if (carry == 0)
+        {
+            if (r != a)
+                copy(a + i, a + an, r + i);
+            return 0;
+        }
+        r[i] = a[i] + 1;
+        carry = r[i] == 0;
+    }
+    return carry;
+}
+
+/**
+ * @brief r = a - b, all of n limbs. long operands go to the vector kernel picked for 
+ * this CPU, short ones stay on the scalar loop
+ * 
+ * @return uint64_t:: borrow out (0 or 1)
+ */
+uint64_t limbs_sub_n(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n)
+{
+    if (n < simd_add_threshold)
+        return limbs_sub_nc(r, a, b, n, 0);
+    static const limbs_carry_kernel kernel = select_limbs_sub_nc();
+    return kernel(r, a, b, n, 0);
+}
+
+/**
+ * @brief r = a - b where a has an limbs, b has bn limbs and an >= bn. r has an limbs. 
+ * above bn the borrow stops as soon as it can, like the carry of limbs_add
+ * 
+ * @return uint64_t:: borrow out (0 or 1)
+ */
+uint64_t limbs_sub(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn)
+{
+    uint64_t borrow = limbs_sub_n(r, a, b, bn);
+    for (size_t i = bn; i < an; i++)
+    {
+        if (borrow == 0)
+        {
+            if (r != a)
+                copy(a + i, a + an, r + i);
+            return 0;
+        }
+        uint64_t a_i = a[i];
+        r[i] = a_i - 1;
+        borrow = a_i == 0;
+    }
+    return borrow;
+}
+
+/**
+ * @brief r = a + b where a has n limbs and b is a single limb. the carry stops as soon as
+ * it can, so in place (r == a) only the limbs it reaches are touched
+ * 
+ * @return uint64_t:: carry out (0 or 1)
+ */
+uint64_t limbs_add_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        r[i] = a[i] + b;
+        if (r[i] >= b)
+        {
+            if (r != a)
+                copy(a + i + 1, a + n, r + i + 1);
+            return 0;
+        }
+        b = 1;
+    }
+    return b;
+}
+
+/**
+ * @brief r = a - b where a has n limbs and b is a single limb. the borrow stops as soon as
+ * it can, so in place (r == a) only the limbs it reaches are touched
+ * 
+ * @return uint64_t:: borrow out (0 or 1)
+ */
+uint64_t limbs_sub_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t a_i = a[i];
+        r[i] = a_i - b;
+        if (a_i >= b)
+        {
+            if (r != a)
+                copy(a + i + 1, a + n, r + i + 1);
+            return 0;
+        }
+        b = 1;
+    }
+    return b;
+}
+
+/**
+ * @brief compares a (an limbs) with b (bn limbs), leading zero limbs are allowed
+ * 
+ * @return int:: 1 if a > b, -1 if a < b, 0 if equal
+ */
+int limbs_cmp(const uint64_t* a, size_t an, const uint64_t* b, size_t bn)
+{
+    while (an > 0 and a[an - 1] == 0)
+        an--;
+    while (bn > 0 and b[bn - 1] == 0)
+        bn--;
+    if (an != bn)
+        return an > bn ? 1 : -1;
+    for (size_t i = an; i >= 1; i--)
+    {
+        if (a[i - 1] != b[i - 1])
+            return a[i - 1] > b[i - 1] ? 1 : -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief r = |a - b| where a has an limbs, b has bn limbs and an >= bn. r has an limbs
+ * 
+ * @return true if a < b (the difference is negative)
+ * @return false else
+ */
+bool limbs_abs_diff(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn)
+{
+    if (limbs_cmp(a, an, b, bn) >= 0)
+    {
+        limbs_sub(r, a, an, b, bn);
+        return false;
+    }
+    // b > a means the limbs of a above bn are all zero
+    limbs_sub_n(r, b, a, bn);
+    fill(r + bn, r + an, 0);
+    return true;
+}
+
+/**
+ * @brief r = a * b where a has n limbs and b is a single limb
+ * 
+ * @return uint64_t:: the limb carried out of the top
+ */
+uint64_t limbs_mul_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    return selected_multiply_kernels().mul_1(r, a, n, b);
+}
+
+/**
+ * @brief r += a * b where a has n limbs and b is a single limb
+ * 
+ * @return uint64_t:: the limb carried out of the top
+ */
+uint64_t limbs_addmul_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    return selected_multiply_kernels().addmul_1(r, a, n, b);
+}
+
+/**
+ * @brief r -= a * b where a has n limbs and b is a single limb
+ * 
+ * @return uint64_t:: the limb borrowed from above the top
+ */
+uint64_t limbs_submul_1(uint64_t* r, const uint64_t* a, size_t n, uint64_t b)
+{
+    return selected_multiply_kernels().submul_1(r, a, n, b);
+}
+
+/**
+ * @brief schoolbook multiplication r = a * b. r has an + bn limbs and is fully written. 
+ * the rows run on the multiply kernels picked for this CPU
+ * 
+ */
+void limbs_mul_basecase(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn)
+{
+    // the carry of each row is propagated once at the end of the row
+    r[an] = limbs_mul_1(r, a, an, b[0]);
+    for (size_t j = 1; j < bn; j++)
+        r[an + j] = limbs_addmul_1(r + j, a, an, b[j]);
+}
+
+/**
+ * @brief r = a << shift for 0 < shift < 64, all of n limbs
+ * 
+ * @return uint64_t:: the bits shifted out of the top limb
+ */
+uint64_t limbs_lshift(uint64_t* r, const uint64_t* a, size_t n, unsigned shift)
+{
+    uint64_t out = a[n - 1] >> (64 - shift);
+    for (size_t i = n - 1; i >= 1; i--)
+        r[i] = (a[i] << shift) | (a[i - 1] >> (64 - shift));
+    r[0] = a[0] << shift;
+    return out;
+}
+
+/**
+ * @brief r = a >> shift for 0 < shift < 64, all of n limbs
+ * 
+ * @return uint64_t:: the bits shifted out of the bottom limb, in the high bits
+ */
+uint64_t limbs_rshift(uint64_t* r, const uint64_t* a, size_t n, unsigned shift)
+{
+    uint64_t out = a[0] << (64 - shift);
+    for (size_t i = 0; i + 1 < n; i++)
+        r[i] = (a[i] >> shift) | (a[i + 1] << (64 - shift));
+    r[n - 1] = a[n - 1] >> shift;
+    return out;
+}
+
+/**
+ * @brief schoolbook squaring r = a^2. r has 2n limbs and is fully written. every cross 
+ * product a[i]*a[j] (i < j) is computed once and doubled, then the squares are added
+ * 
+ */
+void limbs_sqr_basecase(uint64_t* r, const uint64_t* a, size_t n)
+{
+    r[0] = 0;
+    r[2 * n - 1] = 0;
+    if (n > 1)
+    {
+        // row i holds a[i] * a[i+1 ... n-1], starting at limb 2i + 1
+        r[n] = limbs_mul_1(r + 1, a + 1, n - 1, a[0]);
+        for (size_t i = 1; i + 1 < n; i++)
+            r[n + i] = limbs_addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        limbs_lshift(r, r, 2 * n, 1);
+    }
+
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        unsigned __int128 square = (unsigned __int128)a[i] * a[i];
+        unsigned __int128 t = (unsigned __int128)r[2 * i] + (uint64_t)square + carry;
+        r[2 * i] = (uint64_t)t;
+        t = (t >> 64) + r[2 * i + 1] + (uint64_t)(square >> 64);
+        r[2 * i + 1] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+}
+
+/*
+ * Two's complement helpers used by the Toom-Cook evaluation and interpolation. Values 
+ * are fixed-width arrays of n limbs, taken modulo 2^(64 n), so signed additions and 
+ * subtractions need no sign handling and exact divisions stay exact.
+ */
+
+/**
+ * @brief checks the sign bit of an n-limb two's complement value
+ * 
+ */
+bool tc_is_negative(const uint64_t* a, size_t n)
+{
+    return (a[n - 1] >> 63) != 0;
+}
+
+/**
+ * @brief a = -a, in two's complement of n limbs
+ * 
+ */
+void tc_negate(uint64_t* a, size_t n)
+{
+    uint64_t carry = 1;
+    for (size_t i = 0; i < n; i++)
+    {
+        a[i] = ~a[i] + carry;
+        carry = carry and a[i] == 0;
+    }
+}
+
+/**
+ * @brief r = a * x for a small signed x, in two's complement of n limbs
+ * 
+ */
+void tc_mul_small(uint64_t* r, const uint64_t* a, size_t n, int64_t x)
+{
+    limbs_mul_1(r, a, n, x < 0 ? 0 - uint64_t(x) : uint64_t(x));
+    if (x < 0)
+        tc_negate(r, n);
+}
+
+/**
+ * @brief a = a / d for a small signed d that divides a exactly, in two's complement 
+ * of n limbs. the power of two part of d is an arithmetic shift, the odd part is a 
+ * multiplication by its inverse modulo 2^64 carried along the limbs (Hensel division)
+ * 
+ */
+void tc_divexact_small(uint64_t* a, size_t n, int64_t d)
+{
+    uint64_t divisor = d < 0 ? 0 - uint64_t(d) : uint64_t(d);
+    int shift = __builtin_ctzll(divisor);
+    divisor >>= shift;
+
+    if (shift != 0)
+    {
+        for (size_t i = 0; i + 1 < n; i++)
+            a[i] = (a[i] >> shift) | (a[i + 1] << (64 - shift));
+        a[n - 1] = uint64_t(int64_t(a[n - 1]) >> shift);
+    }
+
+    if (divisor != 1)
+    {
+        // Newton iteration for the inverse, each step doubles the number of correct bits
+        uint64_t inverse = divisor;
+        for (int i = 0; i < 5; i++)
+            inverse *= 2 - divisor * inverse;
+
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            uint64_t next_borrow = a[i] < borrow;
+            uint64_t quotient = (a[i] - borrow) * inverse;
+            a[i] = quotient;
+            borrow = (uint64_t)(((unsigned __int128)quotient * divisor) >> 64) + next_borrow;
+        }
+    }
+
+    if (d < 0)
+        tc_negate(a, n);
+}
+
+/*
+ * Multiplication dispatcher. Every tier below works on balanced (or padded) operands 
+ * and calls back into limbs_mul for its sub-products, so each level of the recursion 
+ * picks the best algorithm for its own size. A product whose operands are the same 
+ * array is a square: every tier then passes identical arrays to its sub-products too,
+ * computing each operand-dependent quantity once and reaching limbs_sqr_basecase.
+ */
+
+// operand size (in limbs) from which balanced products switch from Karatsuba to Toom-3
+size_t toom3_threshold = 500;
+// operand size (in limbs) from which balanced products switch from Toom-3 to Toom-4
+size_t toom4_threshold = 1200;
+// operand size (in limbs) from which products switch to the number-theoretic transform
+size_t ntt_threshold = 2000;
+
+enum mul_algorithm
+{
+    MUL_BASECASE,
+    MUL_KARATSUBA,
+    MUL_TOOM32,
+    MUL_TOOM33,
+    MUL_TOOM44,
+    MUL_NTT,
+    MUL_CHUNKED
+};
+
+/**
+ * @brief picks the multiplication algorithm for an an-limb by bn-limb product, an >= bn
+ * 
+ * @return mul_algorithm 
+ */
+mul_algorithm choose_mul_algorithm(size_t an, size_t bn)
+{
+    if (bn < max<size_t>(karatsuba_threshold, 2))
+        return MUL_BASECASE;
+    if (bn >= ntt_threshold)
+        return MUL_NTT;
+    // very unbalanced: cut the longer operand into chunks of the shorter one
+    if (an >= 2 * bn)
+        return MUL_CHUNKED;
+    if (bn >= max<size_t>(toom3_threshold, 8))
+    {
+        // a is about 1.5 times longer than b: split a in 3 pieces and b in 2
+        if (4 * an >= 5 * bn)
+            return MUL_TOOM32;
+        return bn >= toom4_threshold ? MUL_TOOM44 : MUL_TOOM33;
+    }
+    return an == bn ? MUL_KARATSUBA : MUL_CHUNKED;
+}
+
+/**
+ * @brief size of the pieces when a (an limbs) is split in a_pieces and b (bn limbs) 
+ * in b_pieces
+ * 
+ */
+size_t toom_piece_size(size_t an, size_t bn, size_t a_pieces, size_t b_pieces)
+{
+    return max((an + a_pieces - 1) / a_pieces, (bn + b_pieces - 1) / b_pieces);
+}
+
+size_t mul_scratch_size(size_t an, size_t bn);
+size_t ntt_scratch_size(size_t an, size_t bn);
+void limbs_ntt_mul(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn, 
+                   uint64_t* scratch);
+
+/**
+ * @brief number of scratch limbs limbs_karatsuba needs for two n-limb operands
+ * 
+ */
+size_t karatsuba_scratch_size(size_t n)
+{
+    size_t low = n / 2;
+    size_t high = n - low;
+    return 6 * high + 1 + max(mul_scratch_size(low, low), mul_scratch_size(high, high));
+}
+
+/**
+ * @brief number of scratch limbs limbs_toom needs
+ * 
+ */
+size_t toom_scratch_size(size_t an, size_t bn, size_t a_pieces, size_t b_pieces)
+{
+    size_t n = toom_piece_size(an, bn, a_pieces, b_pieces);
+    size_t points = a_pieces + b_pieces - 1;
+    size_t width = 2 * n + 4;
+    return (a_pieces + b_pieces) * n + 2 * (n + 2) + (points + 1) * width + 2 * n + 2 
+           + max(mul_scratch_size(n, n), mul_scratch_size(n + 1, n + 1));
+}
+
+/**
+ * @brief number of scratch limbs limbs_mul needs for an an-limb by bn-limb product, an >= bn
+ * 
+ */
+size_t mul_scratch_size(size_t an, size_t bn)
+{
+    switch (choose_mul_algorithm(an, bn))
+    {
+        case MUL_BASECASE:
+            return 0;
+        case MUL_KARATSUBA:
+            return karatsuba_scratch_size(bn);
+        case MUL_TOOM32:
+            return toom_scratch_size(an, bn, 3, 2);
+        case MUL_TOOM33:
+            return toom_scratch_size(an, bn, 3, 3);
+        case MUL_TOOM44:
+            return toom_scratch_size(an, bn, 4, 4);
+        case MUL_NTT:
+            return ntt_scratch_size(an, bn);
+        case MUL_CHUNKED:
+        default:
+        {
+            size_t last_chunk = an % bn;
+            size_t inner = mul_scratch_size(bn, bn);
+            if (last_chunk != 0)
+                inner = max(inner, mul_scratch_size(bn, last_chunk));
+            return 2 * bn + inner;
+        }
+    }
+}
+
+void limbs_mul(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn, uint64_t* scratch);
+
+/**
+ * @brief r = a * b, both of n limbs
+ * 
+ */
+void limbs_mul_n(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, uint64_t* scratch)
+{
+    limbs_mul(r, a, n, b, n, scratch);
+}
+
+/**
+ * @brief Karatsuba multiplication r = a * b, both of n limbs. with a = a1*B + a0 and 
+ * b = b1*B + b0, the middle term is a0*b0 + a1*b1 - (a1 - a0)*(b1 - b0), so three 
+ * half-size products are enough (three half-size squares when a == b).
+ * r has 2n limbs; scratch has karatsuba_scratch_size(n) limbs
+ * 
+ */
+void limbs_karatsuba(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n, uint64_t* scratch)
+{
+    size_t low = n / 2;
+    size_t high = n - low;
+    const uint64_t* a0 = a;
+    const uint64_t* a1 = a + low;
+    const uint64_t* b0 = b;
+    const uint64_t* b1 = b + low;
+
+    // carve the scratch space of this level, the rest goes to the recursive calls
+    uint64_t* a_diff = scratch;
+    uint64_t* b_diff = a_diff + high;
+    uint64_t* diff_product = b_diff + high;
+    uint64_t* middle = diff_product + 2 * high;
+    uint64_t* next_scratch = middle + 2 * high + 1;
+
+    bool a_negative = limbs_abs_diff(a_diff, a1, high, a0, low);
+    bool b_negative = a_negative;
+    if (a == b)
+        b_diff = a_diff;
+    else
+        b_negative = limbs_abs_diff(b_diff, b1, high, b0, low);
+
+    // a0*b0 goes to r[0, 2 low) and a1*b1 to r[2 low, 2n)
+    limbs_mul_n(r, a0, b0, low, next_scratch);
+    limbs_mul_n(r + 2 * low, a1, b1, high, next_scratch);
+    limbs_mul_n(diff_product, a_diff, b_diff, high, next_scratch);
+
+    // middle = a0*b0 + a1*b1 -/+ |a1 - a0|*|b1 - b0|
+    copy(r, r + 2 * low, middle);
+    fill(middle + 2 * low, middle + 2 * high + 1, 0);
+    middle[2 * high] = limbs_add_n(middle, middle, r + 2 * low, 2 * high);
+    if (a_negative == b_negative)
+        middle[2 * high] -= limbs_sub_n(middle, middle, diff_product, 2 * high);
+    else
+        middle[2 * high] += limbs_add_n(middle, middle, diff_product, 2 * high);
+
+    // r += middle * B
+    limbs_add(r + low, r + low, 2 * n - low, middle, 2 * high + 1);
+}
+
+// finite evaluation points of Toom-Cook, the points 0 and infinity are always used too
+const int64_t TOOM_POINTS[] = {1, -1, 2, -2, 3};
+
+/**
+ * @brief evaluates the polynomial whose coefficients are the k pieces of n limbs at 
+ * x with Horner's rule. r has n + 2 limbs and receives |value|
+ * 
+ * @return true if the value is negative
+ * @return false else
+ */
+bool toom_evaluate(uint64_t* r, const uint64_t* pieces, size_t k, size_t n, int64_t x)
+{
+    copy(pieces + (k - 1) * n, pieces + k * n, r);
+    r[n] = 0;
+    r[n + 1] = 0;
+    for (size_t i = k - 1; i >= 1; i--)
+    {
+        tc_mul_small(r, r, n + 2, x);
+        limbs_add(r, r, n + 2, pieces + (i - 1) * n, n);
+    }
+    bool negative = tc_is_negative(r, n + 2);
+    if (negative)
+        tc_negate(r, n + 2);
+    return negative;
+}
+
+/**
+ * @brief Toom-Cook multiplication r = a * b, with a cut in a_pieces and b in b_pieces 
+ * pieces of n limbs. a and b are seen as polynomials in B = 2^(64 n), evaluated at 0, 
+ * infinity and a_pieces + b_pieces - 3 small integer points, multiplied point-wise 
+ * (recursively) and the product polynomial is interpolated back with divided differences.
+ * r has an + bn limbs; scratch has toom_scratch_size(an, bn, a_pieces, b_pieces) limbs
+ * 
+ */
+void limbs_toom(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn, 
+                size_t a_pieces, size_t b_pieces, uint64_t* scratch)
+{
+    size_t n = toom_piece_size(an, bn, a_pieces, b_pieces);
+    size_t degree = a_pieces + b_pieces - 2;
+    size_t width = 2 * n + 4;
+
+    // carve the scratch space of this level, the rest goes to the point-wise products
+    uint64_t* a_padded = scratch;
+    uint64_t* b_padded = a_padded + a_pieces * n;
+    uint64_t* a_eval = b_padded + b_pieces * n;
+    uint64_t* b_eval = a_eval + n + 2;
+    uint64_t* values = b_eval + n + 2;
+    uint64_t* temp = values + (degree + 1) * width;
+    uint64_t* product = temp + width;
+    uint64_t* next_scratch = product + 2 * n + 2;
+
+    // squaring: b is a, evaluated once and passed as the same array to the sub-products
+    bool square = a == b and an == bn and a_pieces == b_pieces;
+    copy(a, a + an, a_padded);
+    fill(a_padded + an, a_padded + a_pieces * n, 0);
+    if (square)
+    {
+        b_padded = a_padded;
+        b_eval = a_eval;
+    }
+    else
+    {
+        copy(b, b + bn, b_padded);
+        fill(b_padded + bn, b_padded + b_pieces * n, 0);
+    }
+
+    // the lowest and highest coefficients are the products of the lowest and highest pieces
+    uint64_t* lowest = values;
+    uint64_t* highest = values + degree * width;
+    limbs_mul_n(lowest, a_padded, b_padded, n, next_scratch);
+    fill(lowest + 2 * n, lowest + width, 0);
+    limbs_mul_n(highest, a_padded + (a_pieces - 1) * n, b_padded + (b_pieces - 1) * n, n, 
+                next_scratch);
+    fill(highest + 2 * n, highest + width, 0);
+
+    // at each finite point x keep (p(x) - lowest - highest * x^degree) / x, which is the
+    // value at x of the polynomial made of the remaining degree - 1 coefficients
+    size_t middle_count = degree - 1;
+    uint64_t* middle = values + width;
+    for (size_t j = 0; j < middle_count; j++)
+    {
+        int64_t x = TOOM_POINTS[j];
+        uint64_t* value = middle + j * width;
+        bool a_negative = toom_evaluate(a_eval, a_padded, a_pieces, n, x);
+        bool b_negative = square ? a_negative : toom_evaluate(b_eval, b_padded, b_pieces, n, x);
+        limbs_mul_n(product, a_eval, b_eval, n + 1, next_scratch);
+
+        copy(product, product + 2 * n + 2, value);
+        fill(value + 2 * n + 2, value + width, 0);
+        if (a_negative != b_negative)
+            tc_negate(value, width);
+
+        int64_t x_power = 1;
+        for (size_t i = 0; i < degree; i++)
+            x_power *= x;
+        tc_mul_small(temp, highest, width, x_power);
+        limbs_sub_n(value, value, temp, width);
+        limbs_sub_n(value, value, lowest, width);
+        tc_divexact_small(value, width, x);
+    }
+
+    // Newton divided differences, all divisions are exact
+    for (size_t level = 1; level < middle_count; level++)
+    {
+        for (size_t i = middle_count - 1; i >= level; i--)
+        {
+            uint64_t* value = middle + i * width;
+            limbs_sub_n(value, value, value - width, width);
+            tc_divexact_small(value, width, TOOM_POINTS[i] - TOOM_POINTS[i - level]);
+        }
+    }
+
+    // Newton form to monomial form, in place
+    for (size_t i = middle_count - 1; i >= 1; i--)
+    {
+        for (size_t j = i - 1; j + 1 < middle_count; j++)
+        {
+            tc_mul_small(temp, middle + (j + 1) * width, width, TOOM_POINTS[i - 1]);
+            limbs_sub_n(middle + j * width, middle + j * width, temp, width);
+        }
+    }
+
+    // recomposition r = sum of coefficient i * B^i, all coefficients are non-negative
+    size_t rn = an + bn;
+    fill(r, r + rn, 0);
+    for (size_t i = 0; i <= degree and i * n < rn; i++)
+        limbs_add(r + i * n, r + i * n, rn - i * n, values + i * width, min(width, rn - i * n));
+}
+
+/**
+ * @brief r = a * b for an >= 2 bn. a is cut in bn-limb chunks, each chunk product is 
+ * balanced. r has an + bn limbs; scratch has mul_scratch_size(an, bn) limbs
+ * 
+ */
+void limbs_mul_chunked(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn, 
+                       uint64_t* scratch)
+{
+    uint64_t* chunk_product = scratch;
+    uint64_t* next_scratch = scratch + 2 * bn;
+    fill(r, r + an + bn, 0);
+    for (size_t offset = 0; offset < an; offset += bn)
+    {
+        size_t chunk = min(bn, an - offset);
+        if (chunk == bn)
+            limbs_mul_n(chunk_product, a + offset, b, bn, next_scratch);
+        else
+            limbs_mul(chunk_product, b, bn, a + offset, chunk, next_scratch);
+        limbs_add(r + offset, r + offset, an + bn - offset, chunk_product, chunk + bn);
+    }
+}
+
+/**
+ * @brief r = a * b where an >= bn >= 1. r has an + bn limbs; scratch has 
+ * mul_scratch_size(an, bn) limbs. the algorithm is picked by choose_mul_algorithm,
+ * and a == b (same array, same size) selects the squaring variant of that algorithm
+ * 
+ */
+void limbs_mul(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn, uint64_t* scratch)
+{
+    switch (choose_mul_algorithm(an, bn))
+    {
+        case MUL_BASECASE:
+            if (a == b and an == bn)
+                limbs_sqr_basecase(r, a, an);
+            else
+                limbs_mul_basecase(r, a, an, b, bn);
+            break;
+        case MUL_KARATSUBA:
+            limbs_karatsuba(r, a, b, bn, scratch);
+            break;
+        case MUL_TOOM32:
+            limbs_toom(r, a, an, b, bn, 3, 2, scratch);
+            break;
+        case MUL_TOOM33:
+            limbs_toom(r, a, an, b, bn, 3, 3, scratch);
+            break;
+        case MUL_TOOM44:
+            limbs_toom(r, a, an, b, bn, 4, 4, scratch);
+            break;
+        case MUL_NTT:
+            limbs_ntt_mul(r, a, an, b, bn, scratch);
+            break;
+        case MUL_CHUNKED:
+            limbs_mul_chunked(r, a, an, b, bn, scratch);
+            break;
+    }
+}
+
+/**
+ * @brief r = a^2, a has n limbs. r has 2n limbs; scratch has mul_scratch_size(n, n) limbs
+ * 
+ */
+void limbs_sqr(uint64_t* r, const uint64_t* a, size_t n, uint64_t* scratch)
+{
+    limbs_mul(r, a, n, a, n, scratch);
+}
+
+/**********************************************************************
+************************* NTT MULTIPLICATION **************************
+**********************************************************************/
+
+/*
+ * Products of very large operands are computed as cyclic convolutions of their limbs
+ * modulo three primes p = c * 2^50 + 1 just below 2^63, then recombined with the
+ * Chinese remainder theorem. Each coefficient of the convolution is below N * 2^128,
+ * far less than the product of the three primes (about 2^189), so the result is exact.
+ * Arithmetic modulo p is done with Montgomery multiplication, and transforms longer
+ * than ntt_cache_size use the six-step layout: the coefficients are seen as a matrix
+ * whose columns and rows are transformed separately, so every sub-transform fits in cache.
+ */
+
+// longest transform (in coefficients) done in one piece, longer ones use the six-step layout
+size_t ntt_cache_size = 1 << 16;
+// number of matrix columns gathered together by the six-step layout (one cache line)
+const size_t NTT_COLUMN_BLOCK = 8;
+
+struct ntt_prime
+{
+    uint64_t modulus;
+    // generator of the multiplicative group modulo the prime
+    uint64_t generator;
+    // modulus^-1 mod 2^64
+    uint64_t inverse;
+    // 2^128 mod modulus, used to move values into Montgomery form
+    uint64_t r_squared;
+};
+
+/**
+ * @brief precomputes the Montgomery constants of an NTT prime
+ * 
+ * @param modulus prime of the form c * 2^k + 1
+ * @param generator generator of the multiplicative group modulo the prime
+ * @return ntt_prime 
+ */
+ntt_prime make_ntt_prime(uint64_t modulus, uint64_t generator)
+{
+    ntt_prime prime;
+    prime.modulus = modulus;
+    prime.generator = generator;
+    prime.inverse = modulus;
+    for (int i = 0; i < 5; i++)
+        prime.inverse *= 2 - modulus * prime.inverse;
+    uint64_t r = (0 - modulus) % modulus;
+    prime.r_squared = (uint64_t)((unsigned __int128)r * r % modulus);
+    return prime;
+}
+
+const ntt_prime NTT_PRIMES[3] = {
+    make_ntt_prime(0x7fa8000000000001ULL, 3),
+    make_ntt_prime(0x7f18000000000001ULL, 3),
+    make_ntt_prime(0x7e78000000000001ULL, 5)
+};
+
+/**
+ * @brief Montgomery multiplication a * b * 2^-64 mod p, for a, b < p
+ * 
+ */
+uint64_t ntt_mont_mul(uint64_t a, uint64_t b, const ntt_prime& prime)
+{
+    unsigned __int128 t = (unsigned __int128)a * b;
+    uint64_t m = (uint64_t)t * prime.inverse;
+    uint64_t t_high = (uint64_t)(t >> 64);
+    uint64_t mp_high = (uint64_t)(((unsigned __int128)m * prime.modulus) >> 64);
+    // the low limbs of t and m * p are equal, so only the high limbs are subtracted
+    return t_high < mp_high ? t_high - mp_high + prime.modulus : t_high - mp_high;
+}
+
+/**
+ * @brief a mod p, for any 64-bit a. the primes are above 2^62, so a few subtractions do
+ * 
+ */
+uint64_t ntt_reduce(uint64_t a, const ntt_prime& prime)
+{
+    while (a >= prime.modulus)
+        a -= prime.modulus;
+    return a;
+}
+
+/**
+ * @brief (a + b) mod p, for a, b < p
+ * 
+ */
+uint64_t ntt_add(uint64_t a, uint64_t b, const ntt_prime& prime)
+{
+    uint64_t sum = a + b;
+    return sum >= prime.modulus ? sum - prime.modulus : sum;
+}
+
+/**
+ * @brief (a - b) mod p, for a, b < p
+ * 
+ */
+uint64_t ntt_sub(uint64_t a, uint64_t b, const ntt_prime& prime)
+{
+    return a < b ? a - b + prime.modulus : a - b;
+}
+
+/**
+ * @brief a * 2^64 mod p, the Montgomery form of a
+ * 
+ */
+uint64_t ntt_to_mont(uint64_t a, const ntt_prime& prime)
+{
+    return ntt_mont_mul(a, prime.r_squared, prime);
+}
+
+/**
+ * @brief base^exponent mod p, with base and result in Montgomery form
+ * 
+ */
+uint64_t ntt_pow(uint64_t base, uint64_t exponent, const ntt_prime& prime)
+{
+    uint64_t result = ntt_to_mont(1, prime);
+    while (exponent != 0)
+    {
+        if (exponent & 1)
+            result = ntt_mont_mul(result, base, prime);
+        base = ntt_mont_mul(base, base, prime);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief the precomputed roots of unity of one transform length and one prime
+ * 
+ */
+struct ntt_plan
+{
+    // the transform is a matrix of rows x columns coefficients, rows == 1 for short transforms
+    size_t length;
+    size_t rows;
+    size_t columns;
+    // powers of the primitive root of the transforms along a row (length columns) and 
+    // along a column (length rows), and of their inverses. all in Montgomery form
+    vector<uint64_t> row_roots;
+    vector<uint64_t> row_inverse_roots;
+    vector<uint64_t> column_roots;
+    vector<uint64_t> column_inverse_roots;
+    // primitive length-th root of unity and its inverse, for the six-step twiddle factors
+    uint64_t twiddle_root;
+    uint64_t twiddle_inverse_root;
+};
+
+/**
+ * @brief roots[i] = root^i for i < len / 2, root in Montgomery form
+ * 
+ */
+vector<uint64_t> ntt_root_table(size_t len, uint64_t root, const ntt_prime& prime)
+{
+    vector<uint64_t> roots(max<size_t>(len / 2, 1));
+    roots[0] = ntt_to_mont(1, prime);
+    for (size_t i = 1; i < roots.size(); i++)
+        roots[i] = ntt_mont_mul(roots[i - 1], root, prime);
+    return roots;
+}
+
+/**
+ * @brief number of matrix rows of a transform of the given length (power of 2)
+ * 
+ */
+size_t ntt_rows(size_t length)
+{
+    if (length <= ntt_cache_size)
+        return 1;
+    return size_t(1) << (__builtin_ctzll(length) / 2);
+}
+
+/**
+ * @brief precomputes the roots of unity for a transform of the given length (power of 2)
+ * 
+ * @param length 
+ * @param prime 
+ * @return ntt_plan 
+ */
+ntt_plan make_ntt_plan(size_t length, const ntt_prime& prime)
+{
+    ntt_plan plan;
+    plan.length = length;
+    plan.rows = ntt_rows(length);
+    plan.columns = length / plan.rows;
+
+    uint64_t generator = ntt_to_mont(prime.generator, prime);
+    plan.twiddle_root = ntt_pow(generator, (prime.modulus - 1) / length, prime);
+    plan.twiddle_inverse_root = ntt_pow(plan.twiddle_root, prime.modulus - 2, prime);
+
+    uint64_t row_root = ntt_pow(plan.twiddle_root, plan.rows, prime);
+    uint64_t column_root = ntt_pow(plan.twiddle_root, plan.columns, prime);
+    plan.row_roots = ntt_root_table(plan.columns, row_root, prime);
+    plan.row_inverse_roots = ntt_root_table(plan.columns, ntt_pow(row_root, prime.modulus - 2, prime), prime);
+    plan.column_roots = ntt_root_table(plan.rows, column_root, prime);
+    plan.column_inverse_roots = ntt_root_table(plan.rows, ntt_pow(column_root, prime.modulus - 2, prime), prime);
+    return plan;
+}
+
+/**
+ * @brief decimation-in-frequency transform of len (power of 2) values, natural order in, 
+ * bit-reversed order out
+ * 
+ */
+void ntt_forward(uint64_t* a, size_t len, const uint64_t* roots, const ntt_prime& shared_prime)
+{
+    // local copy, so that the compiler knows stores to the values can't change it
+    const ntt_prime prime = shared_prime;
+    for (size_t half = len / 2, stride = 1; half >= 1; half /= 2, stride *= 2)
+    {
+        for (size_t start = 0; start < len; start += 2 * half)
+        {
+            for (size_t j = 0; j < half; j++)
+            {
+                uint64_t u = a[start + j];
+                uint64_t v = a[start + j + half];
+                a[start + j] = ntt_add(u, v, prime);
+                a[start + j + half] = ntt_mont_mul(ntt_sub(u, v, prime), roots[j * stride], prime);
+            }
+        }
+    }
+}
+
+/**
+ * @brief decimation-in-time transform of len (power of 2) values with inverse roots, 
+ * bit-reversed order in, natural order out. the result is len times the inverse transform
+ * 
+ */
+void ntt_inverse(uint64_t* a, size_t len, const uint64_t* roots, const ntt_prime& shared_prime)
+{
+    // local copy, so that the compiler knows stores to the values can't change it
+    const ntt_prime prime = shared_prime;
+    for (size_t half = 1, stride = len / 2; half < len; half *= 2, stride /= 2)
+    {
+        for (size_t start = 0; start < len; start += 2 * half)
+        {
+            for (size_t j = 0; j < half; j++)
+            {
+                uint64_t u = a[start + j];
+                uint64_t v = ntt_mont_mul(a[start + j + half], roots[j * stride], prime);
+                a[start + j] = ntt_add(u, v, prime);
+                a[start + j + half] = ntt_sub(u, v, prime);
+            }
+        }
+    }
+}
+
+/**
+ * @brief bit-reversal permutation of len (power of 2) values
+ * 
+ */
+void ntt_bit_reverse(uint64_t* a, size_t len)
+{
+    for (size_t i = 1, j = 0; i < len; i++)
+    {
+        size_t bit = len >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            swap(a[i], a[j]);
+    }
+}
+
+/**
+ * @brief multiplies column (natural order) by root^(column_index * k) at position k
+ * 
+ */
+void ntt_twiddle(uint64_t* column, size_t len, uint64_t step, const ntt_prime& shared_prime)
+{
+    // local copy, so that the compiler knows stores to the values can't change it
+    const ntt_prime prime = shared_prime;
+    uint64_t factor = ntt_to_mont(1, prime);
+    for (size_t k = 0; k < len; k++)
+    {
+        column[k] = ntt_mont_mul(column[k], factor, prime);
+        factor = ntt_mont_mul(factor, step, prime);
+    }
+}
+
+/**
+ * @brief forward or inverse transform of plan.length values. the forward transform leaves
+ * the values in a permuted order that the inverse transform expects, which is enough for
+ * convolutions. the inverse is not divided by the length.
+ * column_buffer has NTT_COLUMN_BLOCK * plan.rows limbs
+ * 
+ */
+void ntt_transform(uint64_t* a, const ntt_plan& plan, bool inverse, const ntt_prime& prime, 
+                   uint64_t* column_buffer)
+{
+    size_t rows = plan.rows;
+    size_t columns = plan.columns;
+
+    if (inverse)
+    {
+        for (size_t i = 0; i < rows; i++)
+            ntt_inverse(a + i * columns, columns, plan.row_inverse_roots.data(), prime);
+    }
+
+    if (rows > 1)
+    {
+        // columns are gathered NTT_COLUMN_BLOCK at a time, so every row access reads a whole
+        // cache line, transformed with twiddle factors in between, and scattered back
+        uint64_t root = inverse ? plan.twiddle_inverse_root : plan.twiddle_root;
+        uint64_t step = ntt_to_mont(1, prime);
+        for (size_t first = 0; first < columns; first += NTT_COLUMN_BLOCK)
+        {
+            size_t block = min(NTT_COLUMN_BLOCK, columns - first);
+            for (size_t i = 0; i < rows; i++)
+                for (size_t c = 0; c < block; c++)
+                    column_buffer[c * rows + i] = a[i * columns + first + c];
+
+            for (size_t c = 0; c < block; c++)
+            {
+                uint64_t* column = column_buffer + c * rows;
+                if (inverse)
+                {
+                    ntt_twiddle(column, rows, step, prime);
+                    ntt_bit_reverse(column, rows);
+                    ntt_inverse(column, rows, plan.column_inverse_roots.data(), prime);
+                }
+                else
+                {
+                    ntt_forward(column, rows, plan.column_roots.data(), prime);
+                    ntt_bit_reverse(column, rows);
+                    ntt_twiddle(column, rows, step, prime);
+                }
+                step = ntt_mont_mul(step, root, prime);
+            }
+
+            for (size_t i = 0; i < rows; i++)
+                for (size_t c = 0; c < block; c++)
+                    a[i * columns + first + c] = column_buffer[c * rows + i];
+        }
+    }
+
+    if (!inverse)
+    {
+        for (size_t i = 0; i < rows; i++)
+            ntt_forward(a + i * columns, columns, plan.row_roots.data(), prime);
+    }
+}
+
+/**
+ * @brief smallest power of 2 that can hold the convolution of an an-limb and a bn-limb number
+ * 
+ */
+size_t ntt_length(size_t an, size_t bn)
+{
+    size_t length = 1;
+    while (length < an + bn - 1)
+        length *= 2;
+    return length;
+}
+
+/**
+ * @brief number of scratch limbs limbs_ntt_mul needs
+ * 
+ */
+size_t ntt_scratch_size(size_t an, size_t bn)
+{
+    size_t length = ntt_length(an, bn);
+    return 4 * length + NTT_COLUMN_BLOCK * ntt_rows(length);
+}
+
+/**
+ * @brief r = a * b through number-theoretic transforms. r has an + bn limbs; scratch has 
+ * ntt_scratch_size(an, bn) limbs
+ * 
+ */
+void limbs_ntt_mul(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn, 
+                   uint64_t* scratch)
+{
+    size_t length = ntt_length(an, bn);
+    uint64_t* residues[3] = {scratch, scratch + length, scratch + 2 * length};
+    uint64_t* column_buffer = scratch + 4 * length;
+    bool square = a == b and an == bn;
+
+    for (size_t k = 0; k < 3; k++)
+    {
+        const ntt_prime& prime = NTT_PRIMES[k];
+        ntt_plan plan = make_ntt_plan(length, prime);
+        uint64_t* a_transform = residues[k];
+        uint64_t* b_transform = scratch + 3 * length;
+
+        for (size_t i = 0; i < an; i++)
+            a_transform[i] = ntt_reduce(a[i], prime);
+        fill(a_transform + an, a_transform + length, 0);
+        ntt_transform(a_transform, plan, false, prime, column_buffer);
+        if (square)
+        {
+            // one forward transform is enough for a square
+            b_transform = a_transform;
+        }
+        else
+        {
+            for (size_t i = 0; i < bn; i++)
+                b_transform[i] = ntt_reduce(b[i], prime);
+            fill(b_transform + bn, b_transform + length, 0);
+            ntt_transform(b_transform, plan, false, prime, column_buffer);
+        }
+
+        // point-wise products, also divided by the length and taken out of Montgomery form
+        uint64_t scale = ntt_pow(ntt_to_mont(length, prime), prime.modulus - 2, prime);
+        scale = ntt_to_mont(scale, prime);
+        for (size_t i = 0; i < length; i++)
+            a_transform[i] = ntt_mont_mul(ntt_mont_mul(a_transform[i], b_transform[i], prime), scale, prime);
+
+        ntt_transform(a_transform, plan, true, prime, column_buffer);
+    }
+
+    // Garner's recombination: value = x1 + p1 * (x2 + p2 * x3)
+    const ntt_prime& p1 = NTT_PRIMES[0];
+    const ntt_prime& p2 = NTT_PRIMES[1];
+    const ntt_prime& p3 = NTT_PRIMES[2];
+    uint64_t inverse_p1_mod_p2 = ntt_pow(ntt_to_mont(ntt_reduce(p1.modulus, p2), p2), p2.modulus - 2, p2);
+    uint64_t inverse_p1_mod_p3 = ntt_pow(ntt_to_mont(ntt_reduce(p1.modulus, p3), p3), p3.modulus - 2, p3);
+    uint64_t inverse_p2_mod_p3 = ntt_pow(ntt_to_mont(ntt_reduce(p2.modulus, p3), p3), p3.modulus - 2, p3);
+
+    uint64_t acc0 = 0, acc1 = 0, acc2 = 0;
+    for (size_t i = 0; i < an + bn; i++)
+    {
+        if (i < an + bn - 1)
+        {
+            uint64_t x1 = residues[0][i];
+            uint64_t x2 = ntt_mont_mul(ntt_sub(residues[1][i], ntt_reduce(x1, p2), p2), inverse_p1_mod_p2, p2);
+            uint64_t x3 = ntt_mont_mul(ntt_sub(residues[2][i], ntt_reduce(x1, p3), p3), inverse_p1_mod_p3, p3);
+            x3 = ntt_mont_mul(ntt_sub(x3, ntt_reduce(x2, p3), p3), inverse_p2_mod_p3, p3);
+
+            unsigned __int128 t = (unsigned __int128)p2.modulus * x3 + x2;
+            unsigned __int128 low = (unsigned __int128)p1.modulus * (uint64_t)t;
+            unsigned __int128 high = (unsigned __int128)p1.modulus * (uint64_t)(t >> 64);
+            unsigned __int128 middle = (low >> 64) + (uint64_t)high;
+
+            // acc += x1 + p1 * t
+            unsigned __int128 sum = (unsigned __int128)acc0 + (uint64_t)low + x1;
+            acc0 = (uint64_t)sum;
+            sum = (sum >> 64) + acc1 + (uint64_t)middle;
+            acc1 = (uint64_t)sum;
+            acc2 += (uint64_t)(sum >> 64) + (uint64_t)(middle >> 64) + (uint64_t)(high >> 64);
+        }
+        r[i] = acc0;
+        acc0 = acc1;
+        acc1 = acc2;
+        acc2 = 0;
+    }
+}
+
+/**********************************************************************
+************************** DIVISION KERNELS ***************************
+**********************************************************************/
+
+/*
+ * Division works on a normalized divisor (its top bit set), so that the quotient limb
+ * guessed from the two top limbs of the partial remainder is at most two too large.
+ * Small divisors use Knuth's Algorithm D. Large ones use Burnikel-Ziegler recursive
+ * division: a 2n / n division is split into two 3n / 2n divisions, which in turn do one
+ * 2n / n division of half the size and one half-size multiplication, so division costs
+ * a small multiple of a multiplication of the same size. Huge divisors instead use a
+ * fixed-point reciprocal computed by Newton iteration, after which every 2n / n step is
+ * two multiplications. Remainders are left in place in the dividend.
+ */
+
+// divisor size (in limbs) from which operator/= switches from Algorithm D to Burnikel-Ziegler
+size_t bz_threshold = 60;
+// divisor size (in limbs) from which dividing through a precomputed Newton reciprocal beats
+// Burnikel-Ziegler
+size_t newton_threshold = 2000;
+
+/**
+ * @brief q = a / d and returns a % d, where a has n limbs and d is a single nonzero limb
+ * 
+ * @return uint64_t:: the remainder
+ */
+uint64_t limbs_divrem_1(uint64_t* q, const uint64_t* a, size_t n, uint64_t d)
+{
+    unsigned __int128 remainder = 0;
+    for (size_t i = n; i >= 1; i--)
+    {
+        unsigned __int128 current = (remainder << 64) | a[i - 1];
+        q[i - 1] = (uint64_t)(current / d);
+        remainder = current % d;
+    }
+    return (uint64_t)remainder;
+}
+
+/**
+ * @brief a % d where a has n limbs and d is a single nonzero limb
+ * 
+ * @return uint64_t:: the remainder
+ */
+uint64_t limbs_mod_1(const uint64_t* a, size_t n, uint64_t d)
+{
+    unsigned __int128 remainder = 0;
+    for (size_t i = n; i >= 1; i--)
+        remainder = ((remainder << 64) | a[i - 1]) % d;
+    return (uint64_t)remainder;
+}
+
+/**
+ * @brief schoolbook division (Knuth's Algorithm D) of a (an limbs) by d (dn limbs). d must
+ * be normalized and the top dn limbs of a must be less than d. q gets the an - dn limbs of
+ * the quotient; the remainder is left in a[0 .. dn) and the limbs above it are cleared
+ * 
+ */
+void limbs_div_schoolbook(uint64_t* q, uint64_t* a, size_t an, const uint64_t* d, size_t dn)
+{
+    uint64_t d_top = d[dn - 1];
+    if (dn == 1)
+    {
+        // the top limb is below d, so it's the first partial remainder
+        unsigned __int128 remainder = a[an - 1];
+        for (size_t i = an - 1; i >= 1; i--)
+        {
+            unsigned __int128 current = (remainder << 64) | a[i - 1];
+            q[i - 1] = (uint64_t)(current / d_top);
+            remainder = current % d_top;
+        }
+        fill(a, a + an, 0);
+        a[0] = (uint64_t)remainder;
+        return;
+    }
+
+    uint64_t d_next = d[dn - 2];
+    for (size_t j = an - dn; j >= 1; j--)
+    {
+        // divide the dn + 1 limbs of the window by d, the quotient limb is q[j - 1]
+        uint64_t* window = a + j - 1;
+        uint64_t top = window[dn];
+        uint64_t q_hat, r_hat;
+        bool r_hat_fits;
+        if (top >= d_top)
+        {
+            // the window is below d * β, so top == d_top and the guess is β - 1
+            q_hat = ~0ULL;
+            r_hat = window[dn - 1] + d_top;
+            r_hat_fits = r_hat >= d_top;
+        }
+        else
+        {
+            unsigned __int128 current = ((unsigned __int128)top << 64) | window[dn - 1];
+            q_hat = (uint64_t)(current / d_top);
+            r_hat = (uint64_t)(current % d_top);
+            r_hat_fits = true;
+        }
+
+        // the second limb of d leaves q_hat at most one too large
+        while (r_hat_fits and (unsigned __int128)q_hat * d_next
+                              > (((unsigned __int128)r_hat << 64) | window[dn - 2]))
+        {
+            q_hat--;
+            r_hat += d_top;
+            r_hat_fits = r_hat >= d_top;
+        }
+
+        if (limbs_submul_1(window, d, dn, q_hat) > top)
+        {
+            // the window went negative: add d back, the carry cancels the borrow
+            q_hat--;
+            limbs_add_n(window, window, d, dn);
+        }
+        window[dn] = 0;
+        q[j - 1] = q_hat;
+    }
+}
+
+void limbs_div_3n_2n(uint64_t* q, uint64_t* a, const uint64_t* b, size_t h, uint64_t* scratch);
+
+/**
+ * @brief q = a / b where a has 2n limbs, b has n limbs and is normalized, and the top n limbs
+ * of a are less than b. q has n limbs; the remainder is left in a[0 .. n) and a[n .. 2n) is
+ * cleared. scratch has bz_scratch_size(n) limbs
+ * 
+ */
+void limbs_div_2n_1n(uint64_t* q, uint64_t* a, const uint64_t* b, size_t n, uint64_t* scratch)
+{
+    if (n % 2 != 0 or n < bz_threshold)
+    {
+        limbs_div_schoolbook(q, a, 2 * n, b, n);
+        return;
+    }
+
+    // the high three quarters of a give the high half of q, their remainder and the last
+    // quarter of a give the low half
+    size_t h = n / 2;
+    limbs_div_3n_2n(q + h, a + h, b, h, scratch);
+    limbs_div_3n_2n(q, a, b, h, scratch);
+}
+
+/**
+ * @brief q = a / b where a has 3h limbs, b has 2h limbs and is normalized, and the top h limbs
+ * of a are less than b. q has h limbs; the remainder is left in a[0 .. 2h) and a[2h .. 3h) is
+ * cleared. scratch has bz_scratch_size(2h) limbs
+ * 
+ */
+void limbs_div_3n_2n(uint64_t* q, uint64_t* a, const uint64_t* b, size_t h, uint64_t* scratch)
+{
+    // a = [a1 a2 a3] and b = [b1 b2], most significant part first
+    const uint64_t* b1 = b + h;
+    const uint64_t* b2 = b;
+    if (limbs_cmp(a + 2 * h, h, b1, h) < 0)
+    {
+        // q = [a1 a2] / b1, the remainder r1 is left in a[h .. 2h)
+        limbs_div_2n_1n(q, a + h, b1, h, scratch);
+    }
+    else
+    {
+        // a1 == b1: q = β^h - 1 and r1 = [a1 a2] - q * b1 = a2 + b1
+        fill(q, q + h, ~0ULL);
+        fill(a + 2 * h, a + 3 * h, 0);
+        limbs_add(a + h, a + h, 2 * h, b1, h);
+    }
+
+    // the remainder is [r1 a3] - q * b2. the guess q is at most two too large, so it is
+    // fixed by adding b back until the remainder stops being negative
+    uint64_t* product = scratch;
+    limbs_mul(product, q, h, b2, h, scratch + 2 * h);
+    if (limbs_sub(a, a, 3 * h, product, 2 * h))
+    {
+        do
+        {
+            size_t i = 0;
+            while (q[i] == 0)
+                q[i++] = ~0ULL;
+            q[i]--;
+        }
+        while (!limbs_add(a, a, 3 * h, b, 2 * h));
+    }
+}
+
+/**
+ * @brief number of scratch limbs limbs_div_2n_1n needs for an n-limb divisor
+ * 
+ */
+size_t bz_scratch_size(size_t n)
+{
+    if (n % 2 != 0 or n < bz_threshold)
+        return 0;
+    size_t h = n / 2;
+    return max(bz_scratch_size(h), 2 * h + mul_scratch_size(h, h));
+}
+
+/**
+ * @brief the divisor size Burnikel-Ziegler division works with: bn rounded up to m * 2^k
+ * with m < bz_threshold, so that halving it k times always gives even sizes
+ * 
+ */
+size_t bz_block_size(size_t bn)
+{
+    size_t levels = 0;
+    size_t base = bn;
+    while (base >= bz_threshold and base > 1)
+    {
+        levels++;
+        base = ((bn - 1) >> levels) + 1;
+    }
+    return base << levels;
+}
+
+/**
+ * @brief q = a / b where a has 2n limbs, b has n limbs and is normalized, and the top n limbs
+ * of a are less than b. v is the reciprocal of b, floor((β^2n - 1) / b) - β^n. q has n limbs;
+ * the remainder is left in a[0 .. n) and a[n .. 2n) is cleared. scratch has 
+ * newton_div_scratch_size(n) limbs
+ * 
+ */
+void limbs_div_2n_1n_newton(uint64_t* q, uint64_t* a, const uint64_t* b, const uint64_t* v, 
+                            size_t n, uint64_t* scratch)
+{
+    uint64_t* product = scratch;
+    uint64_t* mul_scratch = scratch + 2 * n;
+
+    // q = a_high * (β^n + v) / β^n is never too large and at most a few units too small
+    const uint64_t* a_high = a + n;
+    limbs_mul(product, a_high, n, v, n, mul_scratch);
+    limbs_add_n(q, product + n, a_high, n);
+
+    limbs_mul(product, q, n, b, n, mul_scratch);
+    limbs_sub_n(a, a, product, 2 * n);
+    while (limbs_cmp(a, 2 * n, b, n) >= 0)
+    {
+        limbs_sub(a, a, 2 * n, b, n);
+        size_t i = 0;
+        while (++q[i] == 0)
+            i++;
+    }
+}
+
+/**
+ * @brief number of scratch limbs limbs_div_2n_1n_newton needs for an n-limb divisor
+ * 
+ */
+size_t newton_div_scratch_size(size_t n)
+{
+    return 2 * n + mul_scratch_size(n, n);
+}
+
+/**
+ * @brief one 2n / n step of a long division: limbs_div_2n_1n_newton when the reciprocal v 
+ * of b is given, limbs_div_2n_1n when v is null
+ * 
+ */
+void limbs_div_block(uint64_t* q, uint64_t* a, const uint64_t* b, const uint64_t* v, size_t n,
+                     uint64_t* scratch)
+{
+    if (v != nullptr)
+        limbs_div_2n_1n_newton(q, a, b, v, n, scratch);
+    else
+        limbs_div_2n_1n(q, a, b, n, scratch);
+}
+
+// modulus size (in limbs) from which Barrett reduction uses full multiplications instead 
+// of computing only the product limbs it needs
+size_t barrett_short_product_threshold = 192;
+
+/**
+ * @brief number of scratch limbs limbs_barrett_reduce needs for an n-limb modulus
+ * 
+ */
+size_t barrett_scratch_size(size_t n)
+{
+    // the full products are padded to (n+1 or n+2) x (n+1) and (n+1) x n
+    return 5 * n + 6 + mul_scratch_size(n + 2, n + 1) + mul_scratch_size(n + 1, n + 1) 
+           + mul_scratch_size(n + 1, n);
+}
+
+/**
+ * @brief Barrett reduction r = x mod m, for m of n limbs (top limb nonzero) and x of xn 
+ * limbs with xn <= 2n, given mu = floor(β^2n / m) of mun limbs. the quotient estimate 
+ * q = floor(floor(x / β^(n-1)) mu / β^(n+1)) is at most a few units too small, so 
+ * x - q m is computed modulo β^(n+1) and corrected by subtracting m. below 
+ * barrett_short_product_threshold the two products are computed row by row, skipping 
+ * the low limbs of q mu and the high limbs of q m that the result doesn't depend on
+ * 
+ * @param r n limbs, below m on return
+ * @param scratch barrett_scratch_size(n) limbs
+ */
+void limbs_barrett_reduce(uint64_t* r, const uint64_t* x, size_t xn, const uint64_t* m, size_t n,
+                          const uint64_t* mu, size_t mun, uint64_t* scratch)
+{
+    uint64_t* remainder = scratch;
+    uint64_t* product = scratch + n + 1;
+    uint64_t* mul_scratch = product + 3 * n + 3;
+    fill(remainder, remainder + n + 1, 0);
+    copy(x, x + min(xn, n + 1), remainder);
+
+    const uint64_t* high = x + n - 1;
+    size_t high_n = xn >= n ? xn - n + 1 : 0;
+    while (high_n > 0 and high[high_n - 1] == 0)
+        high_n--;
+
+    if (high_n > 0)
+    {
+        // product = high mu, of which only the limbs from n + 1 up are kept as the quotient
+        size_t product_n = high_n + mun;
+        if (n < barrett_short_product_threshold)
+        {
+            // limbs below n - 1 can only carry 1 into the kept limbs, the estimate 
+            // absorbs it
+            fill(product, product + product_n, 0);
+            for (size_t i = 0; i < high_n; i++)
+            {
+                size_t skip = n - 1 > i ? n - 1 - i : 0;
+                if (skip < mun)
+                    product[i + mun] = limbs_addmul_1(product + i + skip, mu + skip, mun - skip, 
+                                                      high[i]);
+            }
+        }
+        else
+        {
+            // high is padded so that the product stays balanced (mu has n + 1 or n + 2 limbs)
+            uint64_t* padded = mul_scratch;
+            copy(high, high + high_n, padded);
+            fill(padded + high_n, padded + n + 1, 0);
+            limbs_mul(product, mu, mun, padded, n + 1, padded + n + 2);
+            product_n = mun + n + 1;
+        }
+
+        uint64_t* quotient = product + n + 1;
+        size_t quotient_n = product_n > n + 1 ? product_n - n - 1 : 0;
+        while (quotient_n > 0 and quotient[quotient_n - 1] == 0)
+            quotient_n--;
+
+        if (quotient_n > 0)
+        {
+            // remainder -= quotient m modulo β^(n+1)
+            uint64_t* low = product;
+            if (n < barrett_short_product_threshold)
+            {
+                fill(low, low + n + 1, 0);
+                for (size_t j = 0; j < quotient_n and j <= n; j++)
+                {
+                    uint64_t carry = limbs_addmul_1(low + j, m, min(n, n + 1 - j), quotient[j]);
+                    if (j == 0)
+                        low[n] += carry;
+                }
+            }
+            else
+            {
+                // the quotient (below β^(n+1)) is moved out of the way of the product first
+                uint64_t* padded = mul_scratch;
+                copy(quotient, quotient + quotient_n, padded);
+                fill(padded + quotient_n, padded + n + 1, 0);
+                limbs_mul(low, padded, n + 1, m, n, padded + n + 2);
+            }
+            limbs_sub_n(remainder, remainder, low, n + 1);
+        }
+    }
+
+    while (limbs_cmp(remainder, n + 1, m, n) >= 0)
+        limbs_sub(remainder, remainder, n + 1, m, n);
+    copy(remainder, remainder + n, r);
+}
+
+/**********************************************************************
+************************* MONTGOMERY KERNELS **************************
+**********************************************************************/
+
+/*
+ * Montgomery reduction divides by R = β^n modulo an odd m of n limbs: adding a multiple 
+ * of m chosen limb by limb clears the low n limbs, which are then dropped. Exponents are 
+ * scanned left to right with a sliding window, so only odd powers of the base up to 
+ * 2^k - 1 are precomputed and each window costs one multiplication.
+ */
+
+/**
+ * @brief inverse of an odd limb modulo β by Newton iteration, each step doubles the 
+ * number of correct low bits
+ * 
+ * @return uint64_t:: x such that a x = 1 mod 2^64
+ */
+uint64_t limb_inverse(uint64_t a)
+{
+    // correct to 5 bits for every odd a
+    uint64_t x = (3 * a) ^ 2;
+    for (int i = 0; i < 4; i++)
+        x *= 2 - a * x;
+    return x;
+}
+
+/**
+ * @brief Montgomery reduction r = t / β^n mod m, for t of 2n limbs below m β^n. t is 
+ * destroyed, r has n limbs and ends up below m
+ * 
+ * @param m_inverse -m^-1 mod β
+ */
+void limbs_redc(uint64_t* r, uint64_t* t, const uint64_t* m, size_t n, uint64_t m_inverse)
+{
+    // each row clears limb i of t, whose place then keeps the row's carry
+    for (size_t i = 0; i < n; i++)
+        t[i] = limbs_addmul_1(t + i, m, n, t[i] * m_inverse);
+    uint64_t carry = limbs_add_n(r, t + n, t, n);
+    // the sum is below 2m, one subtraction brings it below m
+    if (carry != 0 or limbs_cmp(r, n, m, n) >= 0)
+        limbs_sub_n(r, r, m, n);
+}
+
+/**
+ * @brief number of scratch limbs a Montgomery product of n limbs needs
+ * 
+ */
+size_t montgomery_scratch_size(size_t n)
+{
+    return 2 * n + mul_scratch_size(n, n);
+}
+
+/**
+ * @brief bit i of a little-endian limb array
+ * 
+ */
+bool limbs_bit(const uint64_t* a, size_t i)
+{
+    return (a[i / 64] >> (i % 64)) & 1;
+}
+
+/**
+ * @brief sliding window size for an exponent of the given bit length, trading the 
+ * 2^(k-1) precomputed odd powers against one multiplication per window
+ * 
+ */
+unsigned exponent_window_bits(size_t bits)
+{
+    const size_t limits[] = {7, 25, 81, 241, 673, 1793};
+    unsigned k = 1;
+    while (k <= 6 and bits > limits[k - 1])
+        k++;
+    return k;
+}
+
+/**
+ * @brief next window of a left-to-right sliding-window exponentiation: bit top of e is 
+ * set, and the window is the longest run of at most k bits from top that ends at a set bit
+ * 
+ * @param value receives the window bits, an odd number below 2^k
+ * @return size_t:: the window length
+ */
+size_t exponent_window(const uint64_t* e, size_t top, unsigned k, uint64_t& value)
+{
+    size_t low = top + 1 >= k ? top + 1 - k : 0;
+    while (not limbs_bit(e, low))
+        low++;
+    value = 0;
+    for (size_t i = top + 1; i > low; i--)
+        value = (value << 1) | limbs_bit(e, i - 1);
+    return top + 1 - low;
+}
+
+/**********************************************************************
+*********************** AUXILIARY FUNCTIONS ***************************
+**********************************************************************/
+
+/**
+ * @brief magnitude of a 64-bit integer, negated in unsigned arithmetic so that INT64_MIN 
+ * is handled too
+ * 
+ * @param number 
+ * @return uint64_t 
+ */
+uint64_t int64_magnitude(int64_t number)
+{
+    return number < 0 ? 0 - uint64_t(number) : uint64_t(number);
+}
+
+/**
+ * @brief removes the most significant zero limbs. zero is represented by no limbs at all
+ * 
+ * @param limbs little-endian 64-bit limbs
+ */
+void normalize_limbs(limb_vector& limbs)
+{
+    while (!limbs.empty() and limbs.back() == 0)
+        limbs.pop_back();
+}
+
+/**
+ * @brief limbs = limbs * factor + addend, in place
+ * 
+ * @param limbs little-endian 64-bit limbs
+ * @param factor 
+ * @param addend 
+ */
+void multiply_add_word(limb_vector& limbs, uint64_t factor, uint64_t addend)
+{
+    uint64_t carry = addend;
+    for (size_t i = 0; i < limbs.size(); i++)
+    {
+        unsigned __int128 t = (unsigned __int128)limbs[i] * factor + carry;
+        limbs[i] = (uint64_t)t;
+        carry = (uint64_t)(t >> 64);
+    }
+    if (carry != 0)
+        limbs.push_back(carry);
+}
+
+/**
+ * @brief limbs = limbs / divisor, in place
+ * 
+ * @param limbs little-endian 64-bit limbs
+ * @param divisor should not be zero
+ * @return uint64_t:: remainder of the division
+ */
+uint64_t divide_by_word(limb_vector& limbs, uint64_t divisor)
+{
+    uint64_t remainder = limbs_divrem_1(limbs.data(), limbs.data(), limbs.size(), divisor);
+    normalize_limbs(limbs);
+    return remainder;
+}
+
+/**
+ * @brief adds the magnitude other to limbs in place, in one pass over the limbs. limbs 
+ * only grows (geometrically, see limb_vector::reserve) when other is longer or a carry 
+ * spills out of the top. other may be limbs itself
+ * 
+ * @param limbs magnitude that receives the sum
+ * @param other 
+ */
+void positive_add_in_place(limb_vector& limbs, const limb_vector& other)
+{
+    size_t n = limbs.size();
+    size_t other_n = other.size();
+    uint64_t carry;
+    if (n >= other_n)
+    {
+        carry = limbs_add(limbs.data(), limbs.data(), n, other.data(), other_n);
+    }
+    else
+    {
+        // the sum has the length of other, the low n limbs are added limb by limb in place
+        limbs.resize(other_n);
+        carry = limbs_add(limbs.data(), other.data(), other_n, limbs.data(), n);
+    }
+    if (carry != 0)
+        limbs.push_back(carry);
+}
+
+/**
+ * @brief subtracts the magnitude other from limbs in place, in one pass over the limbs. 
+ * if other is the larger one, limbs receives other - limbs instead. other may be limbs itself
+ * 
+ * @param limbs magnitude that receives the difference
+ * @param other 
+ * @return true if other was larger (the difference is negative)
+ * @return false else
+ */
+bool positive_subtract_in_place(limb_vector& limbs, const limb_vector& other)
+{
+    size_t n = limbs.size();
+    size_t other_n = other.size();
+    bool negative = limbs_cmp(limbs.data(), n, other.data(), other_n) < 0;
+    if (not negative)
+    {
+        limbs_sub(limbs.data(), limbs.data(), n, other.data(), other_n);
+    }
+    else
+    {
+        limbs.resize(other_n);
+        limbs_sub(limbs.data(), other.data(), other_n, limbs.data(), n);
+    }
+    normalize_limbs(limbs);
+    return negative;
+}
+
+/**
+ * @brief multiply two large numbers represented as limbs, without signs
+ * 
+ * @param limbs1 
+ * @param limbs2 
+ * @return limb_vector:: product result
+ */
+limb_vector positive_multiply(const limb_vector& limbs1, const limb_vector& limbs2)
+{
+    if (limbs1.empty() or limbs2.empty())
+        return limb_vector();
+
+    const limb_vector& longer = limbs1.size() >= limbs2.size() ? limbs1 : limbs2;
+    const limb_vector& shorter = limbs1.size() >= limbs2.size() ? limbs2 : limbs1;
+
+    // product is the final result (m-limb * n-limb has at most (m + n) limbs), the scratch 
+    // space of all recursion levels is allocated once here
+    limb_vector product(longer.size() + shorter.size());
+    limb_vector scratch(mul_scratch_size(longer.size(), shorter.size()));
+    limbs_mul(product.data(), longer.data(), longer.size(), shorter.data(), shorter.size(), 
+              scratch.data());
+
+    normalize_limbs(product);
+    return product;
+}
+
+/**
+ * @brief square of a large number represented as limbs
+ * 
+ * @param limbs 
+ * @return limb_vector:: square result
+ */
+limb_vector positive_square(const limb_vector& limbs)
+{
+    if (limbs.empty())
+        return limb_vector();
+
+    limb_vector square(2 * limbs.size());
+    limb_vector scratch(mul_scratch_size(limbs.size(), limbs.size()));
+    limbs_sqr(square.data(), limbs.data(), limbs.size(), scratch.data());
+
+    normalize_limbs(square);
+    return square;
+}
+
+limb_vector newton_reciprocal(const uint64_t* b, size_t n);
+
+/**
+ * @brief divides by a divisor that is already normalized: shifted left by pad limbs and 
+ * shift bits so that its top bit is set. inverse is the reciprocal of the normalized divisor
+ * (see newton_reciprocal), or null to divide with Algorithm D and Burnikel-Ziegler. the 
+ * dividend must not be less than the divisor
+ * 
+ * @param dividend 
+ * @param normalized_divisor 
+ * @param pad 
+ * @param shift 
+ * @param inverse 
+ * @return tuple<limb_vector, limb_vector>:: quotient and remainder
+ */
+tuple<limb_vector, limb_vector> divide_normalized(const limb_vector& dividend, const limb_vector& normalized_divisor,
+                                                  size_t pad, unsigned shift, const limb_vector* inverse)
+{
+    size_t an = dividend.size();
+    size_t n = normalized_divisor.size();
+    size_t bn = n - pad;
+    const uint64_t* divisor = normalized_divisor.data();
+    const uint64_t* reciprocal = inverse != nullptr ? inverse->data() : nullptr;
+
+    // the dividend is shifted the same way, which leaves the quotient unchanged and shifts
+    // the remainder by the same amount
+    limb_vector normalized_dividend(an + pad + 1, 0);
+    if (shift == 0)
+        copy(dividend.begin(), dividend.end(), normalized_dividend.data() + pad);
+    else
+        normalized_dividend[an + pad] = limbs_lshift(normalized_dividend.data() + pad, 
+                                                     dividend.data(), an, shift);
+    size_t len = an + pad + 1;
+    if (normalized_dividend[len - 1] == 0)
+        len--;
+
+    // the dividend is cut into blocks of n limbs from the bottom and divided two blocks at
+    // a time, the remainder of each step becoming the high block of the next one
+    size_t full_blocks = (len - n) / n;
+    size_t partial = (len - n) % n;
+    limb_vector quotient((full_blocks + 1) * n + 1, 0);
+    limb_vector scratch(inverse != nullptr ? newton_div_scratch_size(n) : bz_scratch_size(n));
+
+    if (partial >= bz_threshold)
+    {
+        // a long top block is zero-extended to a whole block
+        normalized_dividend.resize((full_blocks + 2) * n, 0);
+        limbs_div_block(quotient.data() + full_blocks * n, normalized_dividend.data() + full_blocks * n,
+                        divisor, reciprocal, n, scratch.data());
+    }
+    else
+    {
+        // the top n limbs are brought below the divisor with at most one subtraction, then
+        // a short top block is cheap enough for the schoolbook method
+        uint64_t* top = normalized_dividend.data() + full_blocks * n;
+        if (limbs_cmp(top + partial, n, divisor, n) >= 0)
+        {
+            limbs_sub_n(top + partial, top + partial, divisor, n);
+            quotient[len - n] = 1;
+        }
+        if (partial > 0)
+            limbs_div_schoolbook(quotient.data() + full_blocks * n, top, partial + n, divisor, n);
+    }
+
+    for (size_t i = full_blocks; i >= 1; i--)
+        limbs_div_block(quotient.data() + (i - 1) * n, normalized_dividend.data() + (i - 1) * n,
+                        divisor, reciprocal, n, scratch.data());
+    normalize_limbs(quotient);
+
+    limb_vector remainder(bn);
+    if (shift == 0)
+        copy(normalized_dividend.data() + pad, normalized_dividend.data() + n, remainder.data());
+    else
+        limbs_rshift(remainder.data(), normalized_dividend.data() + pad, bn, shift);
+    normalize_limbs(remainder);
+
+    return make_tuple(move(quotient), move(remainder));
+}
+
+/**
+ * @brief shifts a divisor left by pad limbs and as many bits as it takes to set its top bit
+ * 
+ * @param divisor 
+ * @param pad 
+ * @return limb_vector:: the normalized divisor
+ */
+limb_vector normalize_divisor(const limb_vector& divisor, size_t pad)
+{
+    limb_vector normalized(divisor.size() + pad, 0);
+    unsigned shift = __builtin_clzll(divisor.back());
+    if (shift == 0)
+        copy(divisor.begin(), divisor.end(), normalized.data() + pad);
+    else
+        limbs_lshift(normalized.data() + pad, divisor.data(), divisor.size(), shift);
+    return normalized;
+}
+
+/**
+ * @brief divide two large numbers represented as limbs, without signs. the divisor must
+ * not be zero
+ * 
+ * @param dividend 
+ * @param divisor 
+ * @return tuple<limb_vector, limb_vector>:: quotient and remainder
+ */
+tuple<limb_vector, limb_vector> positive_divmod(const limb_vector& dividend, const limb_vector& divisor)
+{
+    if (limbs_cmp(dividend.data(), dividend.size(), divisor.data(), divisor.size()) < 0)
+        return make_tuple(limb_vector(), dividend);
+
+    size_t an = dividend.size();
+    size_t bn = divisor.size();
+    if (bn == 1)
+    {
+        limb_vector quotient(an);
+        uint64_t remainder = limbs_divrem_1(quotient.data(), dividend.data(), an, divisor[0]);
+        normalize_limbs(quotient);
+        return make_tuple(move(quotient), limb_vector(remainder == 0 ? 0 : 1, remainder));
+    }
+
+    // computing a reciprocal costs about two block divisions, so it only pays off for huge
+    // divisors when the quotient is at least twice as long as the divisor
+    unsigned shift = __builtin_clzll(divisor.back());
+    if (bn >= 2 * newton_threshold and an >= 3 * bn)
+    {
+        limb_vector normalized_divisor = normalize_divisor(divisor, 0);
+        limb_vector inverse = newton_reciprocal(normalized_divisor.data(), bn);
+        return divide_normalized(dividend, normalized_divisor, 0, shift, &inverse);
+    }
+
+    // Burnikel-Ziegler needs the divisor padded to a size it can halve evenly, and only pays
+    // off when the quotient is long enough
+    size_t pad = an - bn >= bz_threshold and bn >= bz_threshold ? bz_block_size(bn) - bn : 0;
+    return divide_normalized(dividend, normalize_divisor(divisor, pad), pad, shift, nullptr);
+}
+
+/**
+ * @brief the fixed-point reciprocal of a normalized n-limb b: v = floor((β^2n - 1) / b) - β^n,
+ * also of n limbs. it's computed by Newton iteration with doubling precision from the 
+ * reciprocal of the high half of b, which costs a few multiplications of size n
+ * 
+ * @param b 
+ * @param n 
+ * @return limb_vector:: the reciprocal v
+ */
+limb_vector newton_reciprocal(const uint64_t* b, size_t n)
+{
+    if (n < newton_threshold or n == 1)
+    {
+        // (β^2n - 1) / b is β^n + v, an n + 1 limb quotient with 1 as its top limb
+        limb_vector all_ones(2 * n, ~0ULL);
+        limb_vector divisor(n);
+        copy(b, b + n, divisor.data());
+        limb_vector inverse = get<0>(positive_divmod(all_ones, divisor));
+        inverse.resize(n);
+        return inverse;
+    }
+
+    // x = β^n + v_high β^low, from the reciprocal v_high of the h high limbs of b, 
+    // approximates β^2n / b with a relative error of a few β^-h
+    size_t h = (n + 1) / 2;
+    size_t low = n - h;
+    limb_vector x(n + 1, 0);
+    limb_vector high_inverse = newton_reciprocal(b + low, h);
+    copy(high_inverse.begin(), high_inverse.end(), x.data() + low);
+    x[n] = 1;
+    const uint64_t* x_high = x.data() + low;
+
+    // e = b x - β^2n in two's complement of 2n + 1 limbs, only the h + 1 high limbs of x are
+    // nonzero. its magnitude is below β^(2n - h + 1)
+    limb_vector error(2 * n + 1, 0);
+    limb_vector scratch(mul_scratch_size(n, h + 1));
+    limbs_mul(error.data() + low, b, n, x_high, h + 1, scratch.data());
+    error[2 * n] -= 1;
+    bool x_too_small = tc_is_negative(error.data(), 2 * n + 1);
+    limb_vector residual(error);
+    if (x_too_small)
+        tc_negate(residual.data(), 2 * n + 1);
+
+    // Newton step: x -= x e / β^2n, with e cut to its limbs above β^n. the relative error 
+    // of x becomes about its square, a few units
+    const uint64_t* e_high = residual.data() + n;
+    size_t en = n;
+    while (en > 0 and e_high[en - 1] == 0)
+        en--;
+    if (en > 0)
+    {
+        // c = x e / β^2n = x_high e_high / β^h, and e moves by b c
+        limb_vector product(h + 1 + en);
+        const uint64_t* longer = en > h + 1 ? e_high : x_high;
+        const uint64_t* shorter = en > h + 1 ? x_high : e_high;
+        size_t longer_n = max(en, h + 1);
+        size_t shorter_n = min(en, h + 1);
+        scratch.resize(mul_scratch_size(longer_n, shorter_n));
+        limbs_mul(product.data(), longer, longer_n, shorter, shorter_n, scratch.data());
+        const uint64_t* correction = product.data() + h;
+        size_t cn = en + 1;
+
+        limb_vector error_step(n + cn);
+        scratch.resize(mul_scratch_size(n, cn));
+        if (n >= cn)
+            limbs_mul(error_step.data(), b, n, correction, cn, scratch.data());
+        else
+            limbs_mul(error_step.data(), correction, cn, b, n, scratch.data());
+
+        if (x_too_small)
+        {
+            limbs_add(x.data(), x.data(), n + 1, correction, cn);
+            limbs_add(error.data(), error.data(), 2 * n + 1, error_step.data(), n + cn);
+        }
+        else
+        {
+            limbs_sub(x.data(), x.data(), n + 1, correction, cn);
+            limbs_sub(error.data(), error.data(), 2 * n + 1, error_step.data(), n + cn);
+        }
+    }
+
+    // the reciprocal is the largest x with b x <= β^2n - 1, that is with e < 0. the last
+    // units are fixed one at a time
+    while (!tc_is_negative(error.data(), 2 * n + 1))
+    {
+        limbs_sub(error.data(), error.data(), 2 * n + 1, b, n);
+        size_t i = 0;
+        while (x[i]-- == 0)
+            i++;
+    }
+    while (true)
+    {
+        limbs_add(error.data(), error.data(), 2 * n + 1, b, n);
+        if (!tc_is_negative(error.data(), 2 * n + 1))
+            break;
+        size_t i = 0;
+        while (++x[i] == 0)
+            i++;
+    }
+    x.resize(n);
+    return x;
+}
+
+/**
+ * @brief compares the magnitudes of two normalized limb vectors
+ * 
+ * @param limbs1 
+ * @param limbs2 
+ * @return int:: 1 if |limbs1| > |limbs2|, -1 if |limbs1| < |limbs2|, 0 if equal
+ */
+int compare_abs_values(const limb_vector& limbs1, const limb_vector& limbs2)
+{
+    if (limbs1.size() != limbs2.size())
+        return limbs1.size() > limbs2.size() ? 1 : -1;
+    for (size_t i = limbs1.size(); i >= 1; i--)
+    {
+        if (limbs1[i - 1] != limbs2[i - 1])
+            return limbs1[i - 1] > limbs2[i - 1] ? 1 : -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief checks if the first abs_value is greater than the second
+ * 
+ * @param abs_val1 
+ * @param abs_val2 
+ * @return true abs_val1 > abs_val2
+ * @return false abs_val2 >= abs_val1
+ */
+bool is_first_abs_value_greater(const limb_vector& abs_val1, const limb_vector& abs_val2)
+{
+    return compare_abs_values(abs_val1, abs_val2) > 0;
+}
+
+/**
+ * @brief keeps the low bits of a magnitude, limbs mod 2^bits
+ * 
+ * @param limbs little-endian 64-bit limbs
+ * @param bits 
+ */
+void truncate_bits(limb_vector& limbs, size_t bits)
+{
+    size_t n = (bits + 63) / 64;
+    if (limbs.size() > n)
+        limbs.resize(n);
+    if (limbs.size() == n and bits % 64 != 0)
+        limbs[n - 1] &= (uint64_t(1) << (bits % 64)) - 1;
+    normalize_limbs(limbs);
+}
+
+/**
+ * @brief (a - b) mod 2^bits, computed on fixed-width limbs so that it wraps around
+ * 
+ * @param a 
+ * @param b 
+ * @param bits 
+ * @return limb_vector 
+ */
+limb_vector subtract_mod_power_of_2(limb_vector a, const limb_vector& b, size_t bits)
+{
+    size_t n = (bits + 63) / 64;
+    a.resize(n);
+    limbs_sub(a.data(), a.data(), n, b.data(), min(b.size(), n));
+    truncate_bits(a, bits);
+    return a;
+}
+
+/**
+ * @brief inverse of an odd magnitude modulo 2^bits by Newton iteration, 
+ * x' = x - x (q x - 1), which doubles the number of correct bits at each step
+ * 
+ * @param q odd magnitude
+ * @param bits 
+ * @return limb_vector:: x such that q x = 1 mod 2^bits
+ */
+limb_vector inverse_mod_power_of_2(const limb_vector& q, size_t bits)
+{
+    limb_vector x(1, limb_inverse(q[0]));
+    size_t precision = 64;
+    while (precision < bits)
+    {
+        precision = min(2 * precision, bits);
+        // q x = 1 modulo the previous precision, so q x - 1 doesn't wrap
+        limb_vector error = positive_multiply(q, x);
+        truncate_bits(error, precision);
+        limbs_sub_1(error.data(), error.data(), error.size(), 1);
+        normalize_limbs(error);
+        limb_vector correction = positive_multiply(x, error);
+        x = subtract_mod_power_of_2(x, correction, precision);
+    }
+    truncate_bits(x, bits);
+    return x;
+}
+
+/**
+ * @brief base^exponent mod 2^bits by sliding-window exponentiation, every product 
+ * truncated to bits. used for the power of two part of an even modulus
+ * 
+ * @param base magnitude of the base
+ * @param exponent 
+ * @param bits 
+ * @return limb_vector 
+ */
+limb_vector power_mod_power_of_2(limb_vector base, const limb_vector& exponent, size_t bits)
+{
+    limb_vector result(1, 1);
+    truncate_bits(result, bits);
+    if (exponent.empty())
+        return result;
+
+    truncate_bits(base, bits);
+    size_t top = 64 * exponent.size() - 1 - __builtin_clzll(exponent.back());
+    unsigned k = exponent_window_bits(top + 1);
+    vector<limb_vector> odd_powers(size_t(1) << (k - 1));
+    odd_powers[0] = base;
+    if (k > 1)
+    {
+        limb_vector base_squared = positive_square(base);
+        truncate_bits(base_squared, bits);
+        for (size_t i = 1; i < odd_powers.size(); i++)
+        {
+            odd_powers[i] = positive_multiply(odd_powers[i - 1], base_squared);
+            truncate_bits(odd_powers[i], bits);
+        }
+    }
+
+    uint64_t value;
+    size_t i = top + 1 - exponent_window(exponent.data(), top, k, value);
+    result = odd_powers[value >> 1];
+    // an even base reaches zero after at most bits squarings
+    while (i > 0 and not result.empty())
+    {
+        size_t length = 1;
+        if (limbs_bit(exponent.data(), i - 1))
+            length = exponent_window(exponent.data(), i - 1, k, value);
+        for (size_t j = 0; j < length; j++)
+        {
+            result = positive_square(result);
+            truncate_bits(result, bits);
+        }
+        if (limbs_bit(exponent.data(), i - 1))
+        {
+            result = positive_multiply(result, odd_powers[value >> 1]);
+            truncate_bits(result, bits);
+        }
+        i -= length;
+    }
+    return result;
+}
+
+/**
+ * @brief number of significant bits of a magnitude, 0 for zero
+ * 
+ * @param limbs
+ * @return size_t
+ */
+size_t bit_length(const limb_vector& limbs)
+{
+    if (limbs.empty())
+        return 0;
+    return 64 * limbs.size() - __builtin_clzll(limbs.back());
+}
+
+/**
+ * @brief limbs * 2^bits
+ * 
+ * @param limbs
+ * @param bits
+ * @return limb_vector
+ */
+limb_vector shift_left_bits(const limb_vector& limbs, size_t bits)
+{
+    if (limbs.empty())
+        return limb_vector();
+
+    size_t zero_limbs = bits / 64;
+    limb_vector result(limbs.size() + zero_limbs + 1);
+    if (bits % 64 == 0)
+        copy(limbs.begin(), limbs.end(), result.begin() + zero_limbs);
+    else
+        result[result.size() - 1] = limbs_lshift(result.data() + zero_limbs, limbs.data(), 
+                                                 limbs.size(), bits % 64);
+    normalize_limbs(result);
+    return result;
+}
+
+/**
+ * @brief floor(limbs / 2^bits)
+ * 
+ * @param limbs
+ * @param bits
+ * @return limb_vector
+ */
+limb_vector shift_right_bits(const limb_vector& limbs, size_t bits)
+{
+    size_t zero_limbs = bits / 64;
+    if (zero_limbs >= limbs.size())
+        return limb_vector();
+
+    limb_vector result(limbs.size() - zero_limbs);
+    if (bits % 64 == 0)
+        copy(limbs.begin() + zero_limbs, limbs.end(), result.begin());
+    else
+        limbs_rshift(result.data(), limbs.data() + zero_limbs, result.size(), bits % 64);
+    normalize_limbs(result);
+    return result;
+}
+
+/**
+ * @brief base^exponent by left-to-right sliding-window exponentiation over a table of 
+ * odd powers of the base. the trailing zero bits of the exponent become plain squarings 
+ * at the end, which are the largest and use the squaring kernels
+ * 
+ * @param base 
+ * @param exponent 
+ * @return limb_vector 
+ */
+limb_vector positive_power(const limb_vector& base, uint64_t exponent)
+{
+    if (exponent == 0)
+        return limb_vector(1, 1);
+
+    size_t top = 63 - __builtin_clzll(exponent);
+    unsigned k = exponent_window_bits(top + 1);
+    vector<limb_vector> odd_powers(size_t(1) << (k - 1));
+    odd_powers[0] = base;
+    if (k > 1)
+    {
+        limb_vector base_squared = positive_square(base);
+        for (size_t i = 1; i < odd_powers.size(); i++)
+            odd_powers[i] = positive_multiply(odd_powers[i - 1], base_squared);
+    }
+
+    uint64_t value;
+    size_t i = top + 1 - exponent_window(&exponent, top, k, value);
+    limb_vector result = odd_powers[value >> 1];
+    while (i > 0)
+    {
+        size_t length = 1;
+        if (limbs_bit(&exponent, i - 1))
+            length = exponent_window(&exponent, i - 1, k, value);
+        for (size_t j = 0; j < length; j++)
+            result = positive_square(result);
+        if (limbs_bit(&exponent, i - 1))
+            result = positive_multiply(result, odd_powers[value >> 1]);
+        i -= length;
+    }
+    return result;
+}
+
+/**
+ * @brief floor(x^(1/k)) for k >= 2. the root of x >> k h (about half as many bits) is
+ * computed recursively and scaled by 2^h, which lands within 2^h above the root, then
+ * Newton's iteration y' = ((k - 1) y + x / y^(k-1)) / k, started above the root, doubles
+ * the precision. the top level does the only full-size division, so the whole root costs
+ * a few multiplications of the size of x. roots of up to 32 bits are estimated in long
+ * double and fixed up exactly
+ * 
+ * @param x
+ * @param k
+ * @return limb_vector
+ */
+limb_vector positive_root(const limb_vector& x, uint64_t k)
+{
+    size_t bits = bit_length(x);
+    // 2^k > x, this also keeps huge k away from the powers below
+    if (k >= bits)
+        return x.empty() ? x : limb_vector(1, 1);
+    if ((bits + 31) / 32 <= k)
+    {
+        // log2(x) from the top 64 bits
+        uint64_t top = x.back() << __builtin_clzll(x.back());
+        if (x.size() > 1 and __builtin_clzll(x.back()) != 0)
+            top |= x[x.size() - 2] >> (64 - __builtin_clzll(x.back()));
+        long double log2_x = (long double)bits - 64 + log2l((long double)top);
+        uint64_t estimate = (uint64_t)exp2l(log2_x / k);
+        limb_vector root(1, max(estimate, uint64_t(1)));
+        while (compare_abs_values(positive_power(root, k), x) > 0)
+            limbs_sub_1(root.data(), root.data(), 1, 1);
+        limb_vector next(1, root[0] + 1);
+        while (compare_abs_values(positive_power(next, k), x) <= 0)
+        {
+            root = next;
+            next[0]++;
+        }
+        normalize_limbs(root);
+        return root;
+    }
+
+    size_t h = bits / (2 * k);
+    limb_vector y = positive_root(shift_right_bits(x, k * h), k);
+    positive_add_in_place(y, limb_vector(1, 1));
+    y = shift_left_bits(y, h);
+
+    if (k == 2)
+    {
+        // y - sqrt(x) <= 2^h and sqrt(x) >= 2^(2h - 1/2), so one step ends less than one
+        // above sqrt(x), and never below its floor
+        positive_add_in_place(y, get<0>(positive_divmod(x, y)));
+        y = shift_right_bits(y, 1);
+        if (compare_abs_values(positive_square(y), x) > 0)
+            positive_subtract_in_place(y, limb_vector(1, 1));
+        return y;
+    }
+
+    // the error after the first step is about k / 2, so the iteration stops after a
+    // couple more steps, when it no longer decreases
+    while (true)
+    {
+        limb_vector next = y;
+        multiply_add_word(next, k - 1, 0);
+        positive_add_in_place(next, get<0>(positive_divmod(x, positive_power(y, k - 1))));
+        divide_by_word(next, k);
+        if (compare_abs_values(next, y) >= 0)
+            return y;
+        y = next;
+    }
+}
+
+/**
+ * @brief the primes up to n, by a sieve of Eratosthenes over the odd numbers
+ * 
+ * @param n 
+ * @return vector<uint64_t>:: the primes in increasing order
+ */
+vector<uint64_t> primes_up_to(uint64_t n)
+{
+    vector<uint64_t> primes;
+    if (n < 2)
+        return primes;
+    primes.push_back(2);
+    // composite[i] is true if 2i + 1 is composite
+    vector<bool> composite(n / 2 + 1);
+    for (uint64_t i = 1; 2 * i + 1 <= n; i++)
+    {
+        if (composite[i])
+            continue;
+        uint64_t p = 2 * i + 1;
+        primes.push_back(p);
+        for (uint64_t j = p * p / 2; p <= n / p and 2 * j + 1 <= n; j += p)
+            composite[j] = true;
+    }
+    return primes;
+}
+
+/**
+ * @brief product of words by a balanced product tree. consecutive factors are first 
+ * packed into full limbs, then the limbs are multiplied pairwise, so the multiplications 
+ * high in the tree have operands of the same size and use the fast algorithms
+ * 
+ * @param factors nonzero words, in any order
+ * @return limb_vector 
+ */
+limb_vector word_product(const vector<uint64_t>& factors)
+{
+    vector<limb_vector> level;
+    uint64_t packed = 1;
+    for (size_t i = 0; i < factors.size(); i++)
+    {
+        unsigned __int128 t = (unsigned __int128)packed * factors[i];
+        if (uint64_t(t >> 64) != 0)
+        {
+            level.push_back(limb_vector(1, packed));
+            packed = factors[i];
+        }
+        else
+            packed = uint64_t(t);
+    }
+    level.push_back(limb_vector(1, packed));
+
+    while (level.size() > 1)
+    {
+        for (size_t i = 0; i + 1 < level.size(); i += 2)
+            level[i / 2] = positive_multiply(level[i], level[i + 1]);
+        if (level.size() % 2 == 1)
+            level[level.size() / 2] = level.back();
+        level.resize((level.size() + 1) / 2);
+    }
+    return level[0];
+}
+
+/**********************************************************************
+************************* RADIX CONVERSION ****************************
+**********************************************************************/
+
+/*
+ * strings in a base b are converted by divide and conquer above radix_dc_threshold limbs. 
+ * digits are grouped into chunks of c digits, the most that fit in a limb (19 in base 10). 
+ * a string splits into a low part of c 2^k digits and a high part, converted recursively 
+ * and combined as high b^(c 2^k) + low. a number below b^(c 2^(k+1)) splits by one 
+ * division by b^(c 2^k) into two halves of c 2^k digits each. the powers b^(c 2^k) are 
+ * computed once per base and cached with their reciprocals, so every division is a 
+ * Newton division by a prepared divisor and an n-digit conversion costs O(M(n) log n). 
+ * the cache keeps powers up to radix_cache_limbs limbs for the life of the process, the 
+ * larger powers of a conversion are computed by it and freed when it ends. 
+ * bases 2, 4, 8, 16 and 32 need none of this: their digits are bit fields of the limbs, 
+ * packed and unpacked in linear time.
+ */
+
+// limbs below which radix conversion is done a chunk at a time, in quadratic time
+size_t radix_dc_threshold = 30;
+// limbs up to which the powers of the radix conversion tree are kept in a process-wide cache
+size_t radix_cache_limbs = 1 << 14;
+
+// digits of the bases up to 36, letters are printed lowercase
+const char DIGIT_CHARACTERS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/**
+ * @brief value of a digit in the bases up to 36, letters of either case are accepted
+ * 
+ * @param c 
+ * @return uint64_t:: 36 or more if c isn't a digit
+ */
+uint64_t digit_value(char c)
+{
+    uint64_t value = uint64_t(uint8_t(c)) - '0';
+    if (value < 10)
+        return value;
+    value = (uint64_t(uint8_t(c)) | 0x20) - 'a';
+    return value < 26 ? value + 10 : 36;
+}
+
+/**
+ * @brief the largest power of a base that fits in a limb, and its number of digits
+ * 
+ */
+struct radix_chunk
+{
+    uint64_t power;
+    size_t digits;
+};
+
+/**
+ * @brief the chunk of a base, 10^19 with 19 digits in base 10
+ * 
+ * @param base 
+ * @return radix_chunk 
+ */
+radix_chunk radix_chunk_of(unsigned base)
+{
+    radix_chunk chunk = {base, 1};
+    while (chunk.power <= UINT64_MAX / base)
+    {
+        chunk.power *= base;
+        chunk.digits++;
+    }
+    return chunk;
+}
+
+/**
+ * @brief prepares a power of the radix conversion tree for division. only printing 
+ * divides, so this is done on the first use that asks for it
+ * 
+ * @param power 
+ */
+void prepare_radix_divisor(radix_power& power)
+{
+    if (not power.normalized.empty())
+        return;
+    power.normalized = normalize_divisor(power.power, 0);
+    if (power.power.size() >= newton_threshold)
+        power.inverse = newton_reciprocal(power.normalized.data(), power.normalized.size());
+}
+
+/**
+ * @brief the cached power b^(c 2^k) of a base. the powers are squared up to k on first 
+ * use, and stay at the same address afterwards. a power larger than radix_cache_limbs 
+ * isn't cached
+ * 
+ * @param base 
+ * @param k 
+ * @param divisor true to prepare the power for division
+ * @param levels receives the number of cached levels if k isn't one of them
+ * @return const radix_power*:: nullptr if the power is too large for the cache
+ */
+const radix_power* cached_radix_power(unsigned base, size_t k, bool divisor, size_t& levels)
+{
+    static deque<radix_power> powers[37];
+    static mutex powers_mutex;
+    lock_guard<mutex> lock(powers_mutex);
+    deque<radix_power>& base_powers = powers[base];
+    while (base_powers.size() <= k)
+    {
+        radix_power next;
+        if (base_powers.empty())
+            next.power = limb_vector(1, radix_chunk_of(base).power);
+        else if (2 * base_powers.back().power.size() > radix_cache_limbs)
+        {
+            levels = base_powers.size();
+            return nullptr;
+        }
+        else
+            next.power = positive_square(base_powers.back().power);
+        next.shift = __builtin_clzll(next.power.back());
+        base_powers.push_back(move(next));
+    }
+    radix_power& power = base_powers[k];
+    if (divisor)
+        prepare_radix_divisor(power);
+    return &power;
+}
+
+/**
+ * @brief Construct a new radix_powers::radix_powers object, with no power computed yet
+ * 
+ * @param base from 2 to 36
+ */
+radix_powers::radix_powers(unsigned base) 
+    : base(base), cached_levels(SIZE_MAX)
+{
+}
+
+/**
+ * @brief the power b^(c 2^k), from the cache or squared from the largest cached one. the 
+ * powers stay at the same address while the table lives
+ * 
+ * @param k 
+ * @param divisor true to prepare the power for division
+ * @return const radix_power& 
+ */
+const radix_power& radix_powers::get(size_t k, bool divisor)
+{
+    if (k < cached_levels)
+    {
+        const radix_power* power = cached_radix_power(base, k, divisor, cached_levels);
+        if (power != nullptr)
+            return *power;
+    }
+    while (cached_levels + large.size() <= k)
+    {
+        size_t unused;
+        radix_power next;
+        if (large.empty())
+            next.power = positive_square(cached_radix_power(base, cached_levels - 1, false, unused)->power);
+        else
+            next.power = positive_square(large.back().power);
+        next.shift = __builtin_clzll(next.power.back());
+        large.push_back(move(next));
+    }
+    radix_power& power = large[k - cached_levels];
+    if (divisor)
+        prepare_radix_divisor(power);
+    return power;
+}
+
+/**
+ * @brief the base of the powers
+ * 
+ * @return unsigned 
+ */
+unsigned radix_powers::get_base() const
+{
+    return base;
+}
+
+/**
+ * @brief number of leading '0' characters, compared 8 at a time
+ * 
+ * @param digits 
+ * @param n number of characters
+ * @return size_t 
+ */
+size_t leading_zeros(const char* digits, size_t n)
+{
+    size_t i = 0;
+    uint64_t word;
+    while (i + 8 <= n and (memcpy(&word, digits + i, 8), word == 0x3030303030303030ULL))
+        i += 8;
+    while (i < n and digits[i] == '0')
+        i++;
+    return i;
+}
+
+/**
+ * @brief loads 8 characters into a word, the first one in the lowest byte
+ * 
+ * @param characters 
+ * @return uint64_t 
+ */
+uint64_t load_8_characters(const char* characters)
+{
+    uint64_t word;
+    memcpy(&word, characters, 8);
+#if defined(__BYTE_ORDER__) and __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+/**
+ * @brief stores a word as 8 characters, the lowest byte first
+ * 
+ * @param word 
+ * @param characters 
+ */
+void store_8_characters(uint64_t word, char* characters)
+{
+#if defined(__BYTE_ORDER__) and __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    memcpy(characters, &word, 8);
+}
+
+/**
+ * @brief reads 8 decimal digits as one word (SWAR): the characters are checked and 
+ * combined pairwise into 2, 4 and 8-digit values with three multiplications
+ * 
+ * @param digits 
+ * @param invalid gets nonzero bits if one of the characters isn't a digit
+ * @return uint64_t 
+ */
+uint64_t read_8_digits(const char* digits, uint64_t& invalid)
+{
+    uint64_t word = load_8_characters(digits);
+    // the digits are the bytes 0x30 to 0x39: their high half is 3, and stays 3 when 6 is added
+    invalid |= ((word & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL) | 
+               (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL);
+    // the first character is the lowest byte and the most significant digit
+    word -= 0x3030303030303030ULL;
+    word = word * 10 + (word >> 8);
+    word = ((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) + 
+            ((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >> 32;
+    return word;
+}
+
+/**
+ * @brief marks the bytes of a word that are in [low, high] with their top bit, for words 
+ * whose bytes are all below 0x80 (the sums then never carry into the next byte)
+ * 
+ * @param word 
+ * @param low 
+ * @param high 
+ * @return uint64_t 
+ */
+uint64_t bytes_in_range(uint64_t word, uint8_t low, uint8_t high)
+{
+    const uint64_t ones = 0x0101010101010101ULL;
+    return (word + (0x80 - low) * ones) & ~(word + (0x7F - high) * ones) & (0x80 * ones);
+}
+
+/**
+ * @brief reads 8 hexadecimal digits as one word (SWAR): the characters are checked, 
+ * turned into nibbles and packed pairwise into bytes, 16-bit and 32-bit values
+ * 
+ * @param digits 
+ * @param invalid gets nonzero bits if one of the characters isn't a hexadecimal digit
+ * @return uint64_t 
+ */
+uint64_t read_8_hex_digits(const char* digits, uint64_t& invalid)
+{
+    uint64_t word = load_8_characters(digits);
+    uint64_t is_digit = bytes_in_range(word, '0', '9');
+    uint64_t is_letter = bytes_in_range(word | 0x2020202020202020ULL, 'a', 'f');
+    invalid |= (word & 0x8080808080808080ULL) | (~(is_digit | is_letter) & 0x8080808080808080ULL);
+    // the low half of '0' to '9' is their value, the low half of 'a' to 'f' is 9 less
+    word = (word & 0x0F0F0F0F0F0F0F0FULL) + (is_letter >> 7) * 9;
+    word = ((word << 4) | (word >> 8)) & 0x00FF00FF00FF00FFULL;
+    word = ((word << 8) | (word >> 16)) & 0x0000FFFF0000FFFFULL;
+    return ((word << 16) | (word >> 32)) & 0xFFFFFFFFULL;
+}
+
+/**
+ * @brief writes a 32-bit value as 8 hexadecimal digits (SWAR): the nibbles are spread 
+ * into the bytes of a word and turned into characters all at once
+ * 
+ * @param value 
+ * @param digits 
+ */
+void write_8_hex_digits(uint64_t value, char* digits)
+{
+    uint64_t word = ((value >> 16) | (value << 32)) & 0x0000FFFF0000FFFFULL;
+    word = ((word >> 8) | (word << 16)) & 0x00FF00FF00FF00FFULL;
+    word = ((word >> 4) & 0x000F000F000F000FULL) | ((word & 0x000F000F000F000FULL) << 8);
+    // nibbles from 10 up become 'a' to 'f', 39 characters after '0' + 10
+    word += 0x3030303030303030ULL + (((word + 0x0606060606060606ULL) >> 4) & 0x0101010101010101ULL) * 39;
+    store_8_characters(word, digits);
+}
+
+/**
+ * @brief converts digits (no sign) to limbs a chunk at a time. the digits are checked 
+ * while they are read, and only the result is allocated. decimal digits are read 8 at a 
+ * time
+ * 
+ * @param digits 
+ * @param n number of digits, leading zeros are allowed
+ * @param base from 2 to 36
+ * @param invalid gets nonzero bits if one of the characters isn't a digit
+ * @return limb_vector:: little-endian 64-bit limbs
+ */
+limb_vector digits_to_limbs_basic(const char* digits, size_t n, unsigned base, uint64_t& invalid)
+{
+    radix_chunk chunk = radix_chunk_of(base);
+    limb_vector limbs;
+    limbs.reserve(size_t(double(n) * log2(double(base)) / 64) + 1);
+    // the first chunk takes the leftover digits so that every other chunk is full
+    size_t chunk_size = n % chunk.digits;
+    if (chunk_size == 0)
+        chunk_size = chunk.digits;
+
+    uint64_t factor = 1;
+    for (size_t i = 0; i < chunk_size; i++)
+        factor *= base;
+
+    for (size_t pos = 0; pos < n; pos += chunk_size, chunk_size = chunk.digits)
+    {
+        // in base 10 the digits that don't fill 8 one by one, then 8 at a time
+        uint64_t value = 0;
+        size_t i = pos;
+        for (size_t end = pos + (base == 10 ? chunk_size % 8 : chunk_size); i < end; i++)
+        {
+            uint64_t digit = digit_value(digits[i]);
+            invalid |= digit >= base;
+            value = value * base + digit;
+        }
+        for (; i < pos + chunk_size; i += 8)
+            value = value * 100000000 + read_8_digits(digits + i, invalid);
+        multiply_add_word(limbs, pos == 0 ? factor : chunk.power, value);
+    }
+    normalize_limbs(limbs);
+    return limbs;
+}
+
+/**
+ * @brief converts digits (no sign) to limbs, by divide and conquer for long strings
+ * 
+ * @param digits 
+ * @param n number of digits, leading zeros are allowed
+ * @param powers powers of the base from 2 to 36
+ * @param invalid gets nonzero bits if one of the characters isn't a digit
+ * @return limb_vector:: little-endian 64-bit limbs
+ */
+limb_vector digits_to_limbs(const char* digits, size_t n, radix_powers& powers, uint64_t& invalid)
+{
+    unsigned base = powers.get_base();
+    size_t chunk_digits = radix_chunk_of(base).digits;
+    if (n <= radix_dc_threshold * chunk_digits)
+        return digits_to_limbs_basic(digits, n, base, invalid);
+
+    // the low part is the largest c 2^k digits shorter than the string
+    size_t k = 0;
+    while (chunk_digits << (k + 1) < n)
+        k++;
+    size_t low_digits = chunk_digits << k;
+    limb_vector high = digits_to_limbs(digits, n - low_digits, powers, invalid);
+    limb_vector limbs = positive_multiply(high, powers.get(k, false).power);
+    positive_add_in_place(limbs, digits_to_limbs(digits + n - low_digits, low_digits, powers, invalid));
+    return limbs;
+}
+
+/**
+ * @brief converts digits (no sign) in base 2^bits to limbs in linear time, each digit is a 
+ * bit field of the limbs. in base 16 a limb is 16 digits, read 8 at a time
+ * 
+ * @param digits 
+ * @param n number of digits, leading zeros are allowed
+ * @param bits from 1 to 5
+ * @param invalid gets nonzero bits if one of the characters isn't a digit
+ * @return limb_vector:: little-endian 64-bit limbs
+ */
+limb_vector power_of_2_digits_to_limbs(const char* digits, size_t n, unsigned bits, uint64_t& invalid)
+{
+    limb_vector limbs;
+    limbs.reserve((n * bits + 63) / 64);
+    // the limbs are filled from the last digit
+    if (bits == 4)
+    {
+        for (; n >= 16; n -= 16)
+            limbs.push_back(read_8_hex_digits(digits + n - 16, invalid) << 32 | 
+                            read_8_hex_digits(digits + n - 8, invalid));
+    }
+    uint64_t limb = 0;
+    unsigned filled = 0;
+    for (size_t i = n; i-- > 0;)
+    {
+        uint64_t digit = digit_value(digits[i]);
+        invalid |= digit >> bits;
+        limb |= digit << filled;
+        filled += bits;
+        if (filled >= 64)
+        {
+            // a digit can straddle two limbs
+            limbs.push_back(limb);
+            filled -= 64;
+            limb = filled == 0 ? 0 : digit >> (bits - filled);
+        }
+    }
+    if (filled != 0)
+        limbs.push_back(limb);
+    normalize_limbs(limbs);
+    return limbs;
+}
+
+/**
+ * @brief writes limbs as digits ending at end a chunk at a time, full chunks only. the 
+ * digits above the number are left as they are
+ * 
+ * @param limbs little-endian 64-bit limbs, consumed
+ * @param base from 2 to 36
+ * @param end 
+ */
+void limbs_to_digits_basic(limb_vector& limbs, unsigned base, char* end)
+{
+    radix_chunk chunk = radix_chunk_of(base);
+    while (!limbs.empty())
+    {
+        uint64_t value = divide_by_word(limbs, chunk.power);
+        // the division by a constant 10 is a multiplication
+        if (base == 10)
+            for (size_t i = 0; i < chunk.digits; i++, value /= 10)
+                *--end = char('0' + value % 10);
+        else
+            for (size_t i = 0; i < chunk.digits; i++, value /= base)
+                *--end = DIGIT_CHARACTERS[value % base];
+    }
+}
+
+/**
+ * @brief writes limbs, below b^(c 2^(k+1)), as c 2^(k+1) digits ending at end, by 
+ * dividing into halves by b^(c 2^k). the digits above the number are left as they are
+ * 
+ * @param limbs little-endian 64-bit limbs, consumed
+ * @param powers powers of the base from 2 to 36
+ * @param k 
+ * @param end 
+ */
+void limbs_to_digits_dc(limb_vector& limbs, radix_powers& powers, size_t k, char* end)
+{
+    unsigned base = powers.get_base();
+    if (limbs.size() <= radix_dc_threshold)
+    {
+        limbs_to_digits_basic(limbs, base, end);
+        return;
+    }
+
+    const radix_power& divisor = powers.get(k, true);
+    limb_vector high, low;
+    if (limbs_cmp(limbs.data(), limbs.size(), divisor.power.data(), divisor.power.size()) < 0)
+        swap(low, limbs);
+    else if (divisor.inverse.empty())
+        tie(high, low) = positive_divmod(limbs, divisor.power);
+    else
+        tie(high, low) = divide_normalized(limbs, divisor.normalized, 0, divisor.shift, &divisor.inverse);
+    limbs = limb_vector();
+
+    size_t half = radix_chunk_of(base).digits << k;
+    if (k == 0)
+    {
+        limbs_to_digits_basic(high, base, end - half);
+        limbs_to_digits_basic(low, base, end);
+        return;
+    }
+    limbs_to_digits_dc(high, powers, k - 1, end - half);
+    limbs_to_digits_dc(low, powers, k - 1, end);
+}
+
+/**
+ * @brief converts limbs to digits in base 2^bits in linear time, each digit is a bit field 
+ * of the limbs. in base 16 every limb below the top one is 16 digits, written 8 at a time
+ * 
+ * @param limbs little-endian 64-bit limbs, not empty
+ * @param bits from 1 to 5
+ * @return string 
+ */
+string limbs_to_power_of_2_digits(const limb_vector& limbs, unsigned bits)
+{
+    size_t n = (bit_length(limbs) + bits - 1) / bits;
+    string digits(n, '0');
+    size_t j = 0;
+    if (bits == 4)
+    {
+        for (; j + 1 < limbs.size(); j++)
+        {
+            write_8_hex_digits(limbs[j] >> 32, &digits[n - 16 * j - 16]);
+            write_8_hex_digits(limbs[j] & 0xFFFFFFFFULL, &digits[n - 16 * j - 8]);
+        }
+        j *= 16;
+    }
+    // the digits left one by one, from the last one
+    uint64_t mask = (uint64_t(1) << bits) - 1;
+    for (; j < n; j++)
+    {
+        size_t position = j * bits;
+        size_t limb = position / 64;
+        unsigned offset = position % 64;
+        uint64_t digit = limbs[limb] >> offset;
+        if (offset + bits > 64 and limb + 1 < limbs.size())
+            digit |= limbs[limb + 1] << (64 - offset);
+        digits[n - 1 - j] = DIGIT_CHARACTERS[digit & mask];
+    }
+    return digits;
+}
+
+/**
+ * @brief converts limbs to their string representation (without sign) in a base
+ * 
+ * @param limbs little-endian 64-bit limbs
+ * @param base from 2 to 36
+ * @return string 
+ */
+string limbs_to_digits(limb_vector limbs, unsigned base)
+{
+    if (limbs.empty())
+        return "0";
+    if ((base & (base - 1)) == 0)
+        return limbs_to_power_of_2_digits(limbs, __builtin_ctz(base));
+
+    // the smallest c 2^(k+1) digits that hold the number, or enough chunks for short numbers 
+    // (a chunk holds at least as many bits as the top bit of its power), written 
+    // right-aligned into a buffer of zeros
+    radix_chunk chunk = radix_chunk_of(base);
+    size_t chunk_bits = 63 - __builtin_clzll(chunk.power);
+    size_t digits = chunk.digits * ((64 * limbs.size() + chunk_bits - 1) / chunk_bits);
+    size_t k = 0;
+    radix_powers powers(base);
+    if (limbs.size() > radix_dc_threshold)
+    {
+        while (true)
+        {
+            const limb_vector& power = powers.get(k, false).power;
+            if (2 * power.size() > limbs.size() + 1)
+                break;
+            k++;
+        }
+        digits = chunk.digits << (k + 1);
+    }
+    string result(digits, '0');
+    char* end = &result[0] + result.size();
+    if (limbs.size() > radix_dc_threshold)
+        limbs_to_digits_dc(limbs, powers, k, end);
+    else
+        limbs_to_digits_basic(limbs, base, end);
+
+    size_t first = result.find_first_not_of('0');
+    result.erase(0, first);
+    return result;
+}
+
+/**********************************************************************
+************************** MEMBER FUNCTIONS ***************************
+**********************************************************************/
+
+/**
+ * @brief get sign of a BigInt object
+ * 
+ * @return char 
+ */
+char BigInt::get_sign() const
+{
+    return sign;
+}
+
+/**
+ * @brief get absolute value of a BigInt object as a decimal string
+ * 
+ * @return string 
+ */
+string BigInt::get_abs_value() const
+{
+    return limbs_to_digits(limbs, 10);
+}
+
+/**
+ * @brief get a BigInt object as a string of digits in a base, with a '-' if it's negative
+ * 
+ * @param base from 2 to 36, throws otherwise
+ * @return string 
+ */
+string BigInt::to_string(int base) const
+{
+    if (base < 2 or base > 36)
+        throw invalid_argument("Base must be between 2 and 36!");
+    string digits = limbs_to_digits(limbs, base);
+    return sign == '-' ? '-' + digits : digits;
+}
+
+/**
+ * @brief get absolute value of a BigInt object as little-endian 64-bit limbs
+ * 
+ * @return const limb_vector& 
+ */
+const limb_vector& BigInt::get_limbs() const
+{
+    return limbs;
+}
+
+/**
+ * @brief sets the magnitude from a value of at most two limbs. since limbs has
+ * two inline limbs this never touches the heap
+ * 
+ * @param low least significant limb
+ * @param high most significant limb
+ */
+void BigInt::assign_magnitude(uint64_t low, uint64_t high)
+{
+    limbs.clear();
+    if (low != 0 or high != 0)
+        limbs.push_back(low);
+    if (high != 0)
+        limbs.push_back(high);
+}
+
+/**
+ * @brief adds a signed magnitude of one limb in place. overflow of a one-limb value is 
+ * checked and spills into the second inline limb, longer values carry or borrow only as 
+ * far as needed
+ * 
+ * @param other_sign sign of the other operand
+ * @param other_abs magnitude of the other operand
+ */
+void BigInt::add_word(char other_sign, uint64_t other_abs)
+{
+    if (limbs.size() >= 2)
+    {
+        if (sign == other_sign)
+        {
+            if (limbs_add_1(limbs.data(), limbs.data(), limbs.size(), other_abs))
+                limbs.push_back(1);
+        }
+        else
+        {
+            // the magnitude has two limbs or more, so it stays larger than other_abs
+            limbs_sub_1(limbs.data(), limbs.data(), limbs.size(), other_abs);
+            if (limbs.back() == 0)
+                limbs.pop_back();
+        }
+        return;
+    }
+
+    uint64_t abs_value = limbs.empty() ? 0 : limbs[0];
+    if (sign == other_sign)
+    {
+        uint64_t sum;
+        bool overflow = __builtin_add_overflow(abs_value, other_abs, &sum);
+        assign_magnitude(sum, overflow ? 1 : 0);
+    }
+    else if (abs_value >= other_abs)
+    {
+        assign_magnitude(abs_value - other_abs, 0);
+    }
+    else
+    {
+        assign_magnitude(other_abs - abs_value, 0);
+        sign = other_sign;
+    }
+    if (limbs.empty())
+        sign = '+';
+}
+
+/**
+ * @brief multiplies by a signed magnitude of one limb in place
+ * 
+ * @param other_sign sign of the other operand
+ * @param other_abs magnitude of the other operand
+ */
+void BigInt::multiply_word(char other_sign, uint64_t other_abs)
+{
+    if (other_abs == 0)
+        limbs.clear();
+    else
+    {
+        uint64_t carry = limbs_mul_1(limbs.data(), limbs.data(), limbs.size(), other_abs);
+        if (carry != 0)
+            limbs.push_back(carry);
+    }
+    sign = (sign == other_sign or limbs.empty()) ? '+' : '-';
+}
+
+/**
+ * @brief divides by a signed nonzero magnitude of one limb in place. the quotient is 
+ * truncated toward zero and the remainder has the sign of the dividend
+ * 
+ * @param other_sign sign of the other operand
+ * @param other_abs magnitude of the other operand
+ * @param remainder keep the remainder instead of the quotient
+ */
+void BigInt::divide_word(char other_sign, uint64_t other_abs, bool remainder)
+{
+    if (remainder)
+    {
+        assign_magnitude(limbs_mod_1(limbs.data(), limbs.size(), other_abs), 0);
+        if (limbs.empty())
+            sign = '+';
+    }
+    else
+    {
+        divide_by_word(limbs, other_abs);
+        sign = (sign == other_sign or limbs.empty()) ? '+' : '-';
+    }
+}
+
+/**
+ * @brief sets the magnitude and sign from a 64-bit integer
+ * 
+ * @param number 
+ */
+void BigInt::assign_int64(const int64_t& number)
+{
+    assign_magnitude(int64_magnitude(number), 0);
+    sign = number < 0 ? '-' : '+';
+}
+
+/**
+ * @brief sets the magnitude and sign from a string of digits in a base
+ * 
+ * @param str 
+ * @param base from 2 to 36
+ */
+void BigInt::assign_string(const string& str, unsigned base)
+{
+    // a single pass over the string: the sign, the leading zeros, then the digits, which 
+    // are checked while they are converted
+    const char* digits = str.data();
+    size_t n = str.size();
+    bool negative = n > 0 and digits[0] == '-';
+    if (n > 0 and (digits[0] == '+' or digits[0] == '-'))
+    {
+        digits++;
+        n--;
+    }
+    size_t zeros = leading_zeros(digits, n);
+    uint64_t invalid = 0;
+    limb_vector parsed;
+    if ((base & (base - 1)) == 0)
+        parsed = power_of_2_digits_to_limbs(digits + zeros, n - zeros, __builtin_ctz(base), invalid);
+    else
+    {
+        radix_powers powers(base);
+        parsed = digits_to_limbs(digits + zeros, n - zeros, powers, invalid);
+    }
+    if (invalid != 0)
+        throw invalid_argument(str + " is not a valid integer!");
+    limbs = move(parsed);
+    sign = (negative and !limbs.empty()) ? '-' : '+';
+}
+
+/**********************************************************************
+*************************** CONSTRUCTORS ******************************
+**********************************************************************/
+
+/**
+ * @brief Default Constructor of a new BigInt:: BigInt object
+ * 
+ */
+BigInt::BigInt() 
+{
+    sign = '+';
+}
+
+/**
+ * @brief Construct a new BigInt from 64-bit integer:: BigInt object
+ * 
+ * @param str is a 64-bit integer
+ */
+BigInt::BigInt(const int64_t& number) 
+{
+    assign_int64(number);
+}
+
+/**
+ * @brief Construct a new BigInt from string:: BigInt object
+ * 
+ * @param str is a string
+ */
+BigInt::BigInt(const string& str) 
+{
+    assign_string(str, 10);
+}
+
+/**
+ * @brief builds a BigInt object from a string of digits in a base, with an optional sign. 
+ * letters of either case are digits from 10 up. throws if there is no digit
+ * 
+ * @param str 
+ * @param base from 2 to 36, throws otherwise
+ * @return BigInt 
+ */
+BigInt from_string(const string& str, int base)
+{
+    if (base < 2 or base > 36)
+        throw invalid_argument("Base must be between 2 and 36!");
+    // at least one digit after the sign, as BigIntParser requires
+    size_t sign_length = str.size() > 0 and (str[0] == '+' or str[0] == '-') ? 1 : 0;
+    if (str.size() == sign_length)
+        throw invalid_argument(str + " is not a valid integer!");
+    BigInt result;
+    result.assign_string(str, base);
+    return result;
+}
+
+/**********************************************************************
+*************************** ASSIGNMENT = ******************************
+**********************************************************************/
+
+/**
+ * @brief assigning a previously defined 64-bit integer to a BigInt object
+ * 
+ * @param number 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator=(const int64_t& number) 
+{
+    assign_int64(number);
+    return *this;
+}
+
+/**
+ * @brief assigning a previously defined string to a BigInt object
+ * 
+ * @param str 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator=(const string& str) 
+{
+    assign_string(str, 10);
+    return *this;
+}
+
+/**********************************************************************
+*********************** NEGATION (UNARY - +) **************************
+**********************************************************************/
+
+/**
+ * @brief returns negative of the BigInt object.
+ * 
+ * @return BigInt 
+ */
+BigInt BigInt::operator-() const 
+{
+    BigInt res;
+    if(limbs.empty())
+        return res;
+    else
+    {
+        res.limbs = limbs;
+        res.sign = (sign == '-') ? '+' : '-';
+        return res;
+    }
+}
+
+/**
+ * @brief doesn't do anything to the input BigInt. implemented solely 
+ * for completeness.
+ * 
+ * @return BigInt 
+ */
+BigInt BigInt::operator+() const 
+{
+    return *this;
+}
+
+/**********************************************************************
+************************* ADDITION (+= +) *****************************
+**********************************************************************/
+
+/**
+ * @brief implementing operator += between two BigInt objects
+ * it uses the auxiliary functions positive_add_in_place and positive_subtract_in_place, 
+ * which write into the existing limbs 
+ * 
+ * @param other 
+ * @return BigInt& sum of inputs
+ */
+BigInt& BigInt::operator+=(const BigInt& other)
+{
+    // fast path: the other magnitude fits in one limb
+    if(other.limbs.size() <= 1)
+    {
+        add_word(other.sign, other.limbs.empty() ? 0 : other.limbs[0]);
+        return *this;
+    }
+
+    if(sign == other.sign)
+    {
+        positive_add_in_place(limbs, other.limbs);
+        return *this;
+    }
+    else
+    {
+        if(positive_subtract_in_place(limbs, other.limbs))
+            sign = sign == '+' ? '-' : '+';
+        if(limbs.empty())
+            sign = '+';
+        return *this;
+    }
+}
+
+/**
+ * @brief implementing operator += between BigInt objects and string objects
+ * 
+ * @param other 
+ * @return BigInt& sum of inputs
+ */
+BigInt& BigInt::operator+=(const string& other)
+{
+    *this += BigInt(other);
+    return *this;
+}
+
+/**
+ * @brief implementing operator += between BigInt objects and 
+ * 64-bit integer objects
+ * 
+ * @param other 
+ * @return BigInt& sum of inputs
+ */
+BigInt& BigInt::operator+=(const int64_t& other)
+{
+    add_word(other < 0 ? '-' : '+', int64_magnitude(other));
+    return *this;
+}
+
+/**
+ * @brief adding two BigInt objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator+(BigInt lhs, const BigInt& rhs)
+{
+    return lhs += rhs;
+}
+
+/**
+ * @brief adding BigInt object to string objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator+(const BigInt& lhs, const string& rhs)
+{
+    return lhs + BigInt(rhs);
+}
+
+/**
+ * @brief adding string object to BigInt objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator+(const string& lhs, const BigInt& rhs)
+{
+    return BigInt(lhs) + rhs;
+}
+
+/**
+ * @brief adding BigInt object to 64-bit integer objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator+(BigInt lhs, const int64_t& rhs)
+{
+    return lhs += rhs;
+}
+
+/**
+ * @brief adding 64-bit integer objects to BigInt object
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator+(const int64_t& lhs, BigInt rhs)
+{
+    return rhs += lhs;
+}
+
+/**********************************************************************
+************************ SUBTRACTION (- -=) ***************************
+**********************************************************************/
+
+/**
+ * @brief implementing operator -= between two BigInt objects
+ * it uses the auxiliary functions positive_add_in_place and positive_subtract_in_place, 
+ * which write into the existing limbs 
+ * 
+ * @param other 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator-=(const BigInt& other)
+{
+    // fast path: the other magnitude fits in one limb
+    if(other.limbs.size() <= 1)
+    {
+        add_word(other.sign == '+' ? '-' : '+', other.limbs.empty() ? 0 : other.limbs[0]);
+        return *this;
+    }
+
+    if(sign != other.sign)
+    {
+        positive_add_in_place(limbs, other.limbs);
+        return *this;
+    }
+    else
+    {
+        if(positive_subtract_in_place(limbs, other.limbs))
+            sign = sign == '+' ? '-' : '+';
+        if(limbs.empty())
+            sign = '+';
+        return *this;
+    }
+}
+
+/**
+ * @brief implementing operator -= between BigInt objects and string objects
+ * 
+ * @param other 
+ * @return BigInt& sum of inputs
+ */
+BigInt& BigInt::operator-=(const string& other)
+{
+    *this -= BigInt(other);
+    return *this;
+}
+
+/**
+ * @brief implementing operator -= between BigInt objects and 
+ * 64-bit integer objects
+ * 
+ * @param other 
+ * @return BigInt& sum of inputs
+ */
+BigInt& BigInt::operator-=(const int64_t& other)
+{
+    add_word(other < 0 ? '+' : '-', int64_magnitude(other));
+    return *this;
+}
+
+/**
+ * @brief subtracting two BigInt objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator-(BigInt lhs, const BigInt& rhs)
+{
+    return lhs -= rhs;
+}
+
+/**
+ * @brief subtracting BigInt object to string objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator-(const BigInt& lhs, const string& rhs)
+{
+    return lhs - BigInt(rhs);
+}
+
+/**
+ * @brief subtracting string object to BigInt objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator-(const string& lhs, const BigInt& rhs)
+{
+    return BigInt(lhs) - rhs;
+}
+
+/**
+ * @brief subtracting BigInt object to 64-bit integer objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator-(BigInt lhs, const int64_t& rhs)
+{
+    return lhs -= rhs;
+}
+
+/**
+ * @brief subtracting 64-bit integer objects to BigInt object
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator-(const int64_t& lhs, BigInt rhs)
+{
+    if (not rhs.limbs.empty())
+        rhs.sign = rhs.sign == '+' ? '-' : '+';
+    rhs.add_word(lhs < 0 ? '-' : '+', int64_magnitude(lhs));
+    return rhs;
+}
+
+/**
+ * @brief multiplying two BigInt objects
+ * 
+ * @param lhs 
+ * @param rhs 
+ * @return BigInt 
+ */
+
+/**********************************************************************
+********************** MULTIPLICATION (* *=) **************************
+**********************************************************************/
+
+/**
+ * @brief implementing operator *= between two BigInt objects
+ * it uses the auxiliary function positive_multiply, which picks the multiplication 
+ * algorithm by operand size, or positive_square when both operands are equal 
+ * 
+ * @param other 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator*=(const BigInt& other) 
+{   
+    // fast path: the other magnitude fits in one limb, multiply in place
+    if(other.limbs.size() <= 1 and &other != this)
+    {
+        multiply_word(other.sign, other.limbs.empty() ? 0 : other.limbs[0]);
+        return *this;
+    }
+
+    // x *= x, or two equal magnitudes: use the squaring kernels
+    if(&other == this or limbs == other.limbs)
+    {
+        limbs = positive_square(limbs);
+        sign = (sign == other.sign or limbs.empty()) ? '+' : '-';
+        return *this;
+    }
+
+    limbs = positive_multiply(limbs, other.limbs);
+    sign = (sign == other.sign or limbs.empty()) ? '+' : '-';
+    return *this;
+}
+
+/**
+ * @brief returns the square of a BigInt object. it uses the auxiliary function 
+ * positive_square, which computes every cross product only once
+ * 
+ * @return BigInt 
+ */
+BigInt BigInt::square() const
+{
+    BigInt res;
+    res.limbs = positive_square(limbs);
+    return res;
+}
+
+/**
+ * @brief implementing operator *= between BigInt objects and string objects
+ * 
+ * @param other 
+ * @return BigInt& sum of inputs
+ */
+BigInt& BigInt::operator*=(const string& other)
+{
+    *this *= BigInt(other);
+    return *this;
+}
+
+/**
+ * @brief implementing operator *= between BigInt objects and 
+ * 64-bit integer objects
+ * 
+ * @param other 
+ * @return BigInt& sum of inputs
+ */
+BigInt& BigInt::operator*=(const int64_t& other)
+{
+    multiply_word(other < 0 ? '-' : '+', int64_magnitude(other));
+    return *this;
+}
+
+BigInt operator*(BigInt lhs, const BigInt& rhs)
+{
+    return lhs *= rhs;
+}
+
+/**
+ * @brief multiplying BigInt object to string objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator*(const BigInt& lhs, const string& rhs)
+{
+    return lhs * BigInt(rhs);
+}
+
+/**
+ * @brief multiplying string object to BigInt objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator*(const string& lhs, const BigInt& rhs)
+{
+    return BigInt(lhs) * rhs;
+}
+
+/**
+ * @brief multiplying BigInt object to 64-bit integer objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator*(BigInt lhs, const int64_t& rhs)
+{
+    return lhs *= rhs;
+}
+
+/**
+ * @brief multiplying 64-bit integer objects to BigInt object
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator*(const int64_t& lhs, BigInt rhs)
+{
+    return rhs *= lhs;
+}
+
+/**********************************************************************
+************************ DIVISION (/ /= % %=) *************************
+**********************************************************************/
+
+/**
+ * @brief divides two BigInt objects in one pass. it uses the auxiliary function 
+ * positive_divmod, which picks the division algorithm by operand size. the quotient is 
+ * truncated toward zero and the remainder has the sign of the dividend, like the 
+ * built-in integers
+ * 
+ * @param lhs dividend
+ * @param rhs divisor, throws if it's zero
+ * @return tuple<BigInt, BigInt>:: quotient and remainder
+ */
+tuple<BigInt, BigInt> divmod(const BigInt& lhs, const BigInt& rhs)
+{
+    if(rhs.limbs.empty())
+        throw invalid_argument("Division by zero!");
+
+    BigInt quotient, remainder;
+    // fast path: both magnitudes fit in one limb
+    if(lhs.limbs.size() <= 1 and rhs.limbs.size() == 1)
+    {
+        uint64_t dividend = lhs.limbs.empty() ? 0 : lhs.limbs[0];
+        quotient.assign_magnitude(dividend / rhs.limbs[0], 0);
+        remainder.assign_magnitude(dividend % rhs.limbs[0], 0);
+    }
+    else
+    {
+        tie(quotient.limbs, remainder.limbs) = positive_divmod(lhs.limbs, rhs.limbs);
+    }
+    quotient.sign = (lhs.sign == rhs.sign or quotient.limbs.empty()) ? '+' : '-';
+    remainder.sign = remainder.limbs.empty() ? '+' : lhs.sign;
+    return make_tuple(move(quotient), move(remainder));
+}
+
+/**
+ * @brief implementing operator /= between two BigInt objects
+ * 
+ * @param other 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator/=(const BigInt& other)
+{
+    // fast path: a divisor of one limb is divided out in place
+    if (other.limbs.size() == 1)
+    {
+        divide_word(other.sign, other.limbs[0], false);
+        return *this;
+    }
+    *this = get<0>(divmod(*this, other));
+    return *this;
+}
+
+/**
+ * @brief implementing operator /= between BigInt objects and string objects
+ * 
+ * @param other 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator/=(const string& other)
+{
+    *this /= BigInt(other);
+    return *this;
+}
+
+/**
+ * @brief implementing operator /= between BigInt objects and 
+ * 64-bit integer objects
+ * 
+ * @param other 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator/=(const int64_t& other)
+{
+    if (other == 0)
+        throw invalid_argument("Division by zero!");
+    divide_word(other < 0 ? '-' : '+', int64_magnitude(other), false);
+    return *this;
+}
+
+/**
+ * @brief implementing operator %= between two BigInt objects
+ * 
+ * @param other 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator%=(const BigInt& other)
+{
+    // fast path: a divisor of one limb leaves a remainder of one limb
+    if (other.limbs.size() == 1)
+    {
+        divide_word(other.sign, other.limbs[0], true);
+        return *this;
+    }
+    *this = get<1>(divmod(*this, other));
+    return *this;
+}
+
+/**
+ * @brief implementing operator %= between BigInt objects and string objects
+ * 
+ * @param other 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator%=(const string& other)
+{
+    *this %= BigInt(other);
+    return *this;
+}
+
+/**
+ * @brief implementing operator %= between BigInt objects and 
+ * 64-bit integer objects
+ * 
+ * @param other 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator%=(const int64_t& other)
+{
+    if (other == 0)
+        throw invalid_argument("Division by zero!");
+    divide_word(other < 0 ? '-' : '+', int64_magnitude(other), true);
+    return *this;
+}
+
+BigInt operator/(BigInt lhs, const BigInt& rhs)
+{
+    return lhs /= rhs;
+}
+
+/**
+ * @brief dividing BigInt object by string objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator/(const BigInt& lhs, const string& rhs)
+{
+    return lhs / BigInt(rhs);
+}
+
+/**
+ * @brief dividing string object by BigInt objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator/(const string& lhs, const BigInt& rhs)
+{
+    return BigInt(lhs) / rhs;
+}
+
+/**
+ * @brief dividing BigInt object by 64-bit integer objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator/(BigInt lhs, const int64_t& rhs)
+{
+    return lhs /= rhs;
+}
+
+/**
+ * @brief dividing 64-bit integer objects by BigInt object
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator/(const int64_t& lhs, BigInt rhs)
+{
+    return BigInt(lhs) / rhs;
+}
+
+BigInt operator%(BigInt lhs, const BigInt& rhs)
+{
+    return lhs %= rhs;
+}
+
+/**
+ * @brief remainder of BigInt object divided by string objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator%(const BigInt& lhs, const string& rhs)
+{
+    return lhs % BigInt(rhs);
+}
+
+/**
+ * @brief remainder of string object divided by BigInt objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator%(const string& lhs, const BigInt& rhs)
+{
+    return BigInt(lhs) % rhs;
+}
+
+/**
+ * @brief remainder of BigInt object divided by 64-bit integer objects
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator%(const BigInt& lhs, const int64_t& rhs)
+{
+    // the remainder is read off without copying lhs, it's smaller than |rhs| so it fits
+    if (rhs == 0)
+        throw invalid_argument("Division by zero!");
+    const limb_vector& limbs = lhs.get_limbs();
+    uint64_t remainder = limbs_mod_1(limbs.data(), limbs.size(), int64_magnitude(rhs));
+    return lhs.get_sign() == '-' ? -int64_t(remainder) : int64_t(remainder);
+}
+
+/**
+ * @brief remainder of 64-bit integer objects divided by BigInt object
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator%(const int64_t& lhs, BigInt rhs)
+{
+    return BigInt(lhs) % rhs;
+}
+
+/**********************************************************************
+************************ RECIPROCAL DIVISION **************************
+**********************************************************************/
+
+/**
+ * @brief prepares a divisor for repeated divisions. the reciprocal is only computed for 
+ * divisors of at least newton_threshold limbs, shorter ones are faster to divide by directly
+ * 
+ * @param other the divisor, throws if it's zero
+ */
+BigIntReciprocal::BigIntReciprocal(const BigInt& other)
+{
+    if(other.get_limbs().empty())
+        throw invalid_argument("Division by zero!");
+
+    divisor = other;
+    const limb_vector& limbs = other.get_limbs();
+    normalized_divisor = normalize_divisor(limbs, 0);
+    shift = __builtin_clzll(limbs.back());
+    if(limbs.size() >= newton_threshold)
+        inverse = newton_reciprocal(normalized_divisor.data(), normalized_divisor.size());
+}
+
+/**
+ * @brief get the divisor of a BigIntReciprocal object
+ * 
+ * @return const BigInt& 
+ */
+const BigInt& BigIntReciprocal::get_divisor() const
+{
+    return divisor;
+}
+
+/**
+ * @brief divides a BigInt object by a prepared divisor in one pass, with the same signs 
+ * as divmod between two BigInt objects
+ * 
+ * @param lhs dividend
+ * @param rhs prepared divisor
+ * @return tuple<BigInt, BigInt>:: quotient and remainder
+ */
+tuple<BigInt, BigInt> divmod(const BigInt& lhs, const BigIntReciprocal& rhs)
+{
+    const BigInt& divisor = rhs.divisor;
+    if(rhs.inverse.empty() or compare_abs_values(lhs.limbs, divisor.limbs) < 0)
+        return divmod(lhs, divisor);
+
+    BigInt quotient, remainder;
+    tie(quotient.limbs, remainder.limbs) = divide_normalized(lhs.limbs, rhs.normalized_divisor, 0, 
+                                                             rhs.shift, &rhs.inverse);
+    quotient.sign = (lhs.sign == divisor.sign or quotient.limbs.empty()) ? '+' : '-';
+    remainder.sign = remainder.limbs.empty() ? '+' : lhs.sign;
+    return make_tuple(move(quotient), move(remainder));
+}
+
+/**
+ * @brief implementing operator /= between BigInt objects and prepared divisors
+ * 
+ * @param other 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator/=(const BigIntReciprocal& other)
+{
+    *this = get<0>(divmod(*this, other));
+    return *this;
+}
+
+/**
+ * @brief implementing operator %= between BigInt objects and prepared divisors
+ * 
+ * @param other 
+ * @return BigInt& 
+ */
+BigInt& BigInt::operator%=(const BigIntReciprocal& other)
+{
+    *this = get<1>(divmod(*this, other));
+    return *this;
+}
+
+/**
+ * @brief dividing BigInt object by a prepared divisor
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator/(BigInt lhs, const BigIntReciprocal& rhs)
+{
+    return lhs /= rhs;
+}
+
+/**
+ * @brief remainder of BigInt object divided by a prepared divisor
+ * 
+ * @param lhs left operand
+ * @param rhs right operand
+ * @return BigInt 
+ */
+BigInt operator%(BigInt lhs, const BigIntReciprocal& rhs)
+{
+    return lhs %= rhs;
+}
+
+/**********************************************************************
+*************************** EXPONENTIATION ****************************
+**********************************************************************/
+
+/**
+ * @brief base^exponent, 0^0 is 1. a base 2^t q with q odd is raised as q^exponent shifted 
+ * by t * exponent bits, so powers of two (2, 16, ...) are a single shift and powers of 10 
+ * are powers of 5, which are about a third shorter, plus a shift
+ * 
+ * @param base 
+ * @param exponent throws if t * exponent doesn't fit in a size_t
+ * @return BigInt 
+ */
+BigInt pow(const BigInt& base, uint64_t exponent)
+{
+    BigInt result = 1;
+    if (exponent == 0)
+        return result;
+    if (base.limbs.empty())
+        return BigInt();
+
+    size_t zero_limbs = 0;
+    while (base.limbs[zero_limbs] == 0)
+        zero_limbs++;
+    size_t t = 64 * zero_limbs + __builtin_ctzll(base.limbs[zero_limbs]);
+    if (t != 0 and exponent > SIZE_MAX / t)
+        throw invalid_argument("Exponent too large!");
+
+    limb_vector odd_part = shift_right_bits(base.limbs, t);
+    if (odd_part.size() > 1 or odd_part[0] != 1)
+        result.limbs = positive_power(odd_part, exponent);
+    result.limbs = shift_left_bits(result.limbs, t * exponent);
+    result.sign = base.sign == '-' and exponent % 2 == 1 ? '-' : '+';
+    return result;
+}
+
+/**********************************************************************
+*********************** MODULAR EXPONENTIATION ************************
+**********************************************************************/
+
+/**
+ * @brief prepares an odd modulus for Montgomery multiplication: -m^-1 mod β and 
+ * R^2 mod m are computed once
+ * 
+ * @param other the modulus, throws if it's even. its sign is ignored
+ */
+BigIntMontgomery::BigIntMontgomery(const BigInt& other)
+{
+    const limb_vector& limbs = other.get_limbs();
+    if(limbs.empty() or limbs[0] % 2 == 0)
+        throw invalid_argument("Montgomery modulus must be odd!");
+
+    modulus = other.get_sign() == '-' ? -other : other;
+    m_inverse = 0 - limb_inverse(limbs[0]);
+    limb_vector r_squared_power(2 * limbs.size() + 1);
+    r_squared_power.back() = 1;
+    r_squared = get<1>(positive_divmod(r_squared_power, limbs));
+    r_squared.resize(limbs.size());
+}
+
+/**
+ * @brief get the modulus of a BigIntMontgomery object
+ * 
+ * @return const BigInt& 
+ */
+const BigInt& BigIntMontgomery::get_modulus() const
+{
+    return modulus;
+}
+
+/**
+ * @brief Montgomery product r = a b / R mod m of n-limb values below m. scratch holds 
+ * montgomery_scratch_size(n) limbs
+ * 
+ */
+void BigIntMontgomery::multiply(uint64_t* r, const uint64_t* a, const uint64_t* b, 
+                                uint64_t* scratch) const
+{
+    const limb_vector& m = modulus.get_limbs();
+    size_t n = m.size();
+    limbs_mul(scratch, a, n, b, n, scratch + 2 * n);
+    limbs_redc(r, scratch, m.data(), n, m_inverse);
+}
+
+/**
+ * @brief base^exponent mod m by sliding-window exponentiation in Montgomery form
+ * 
+ * @param base magnitude below the modulus
+ * @param exponent 
+ * @return limb_vector 
+ */
+limb_vector BigIntMontgomery::power(const limb_vector& base, const limb_vector& exponent) const
+{
+    const limb_vector& m = modulus.get_limbs();
+    size_t n = m.size();
+    if(exponent.empty())
+    {
+        limb_vector one(1, 1);
+        if(m == one)
+            one.clear();
+        return one;
+    }
+
+    limb_vector scratch(montgomery_scratch_size(n));
+    size_t top = 64 * exponent.size() - 1 - __builtin_clzll(exponent.back());
+    unsigned k = exponent_window_bits(top + 1);
+
+    // base^1, base^3, ..., base^(2^k - 1) in Montgomery form, n limbs each
+    limb_vector odd_powers(n << (k - 1));
+    limb_vector x(base);
+    x.resize(n);
+    multiply(odd_powers.data(), x.data(), r_squared.data(), scratch.data());
+    if(k > 1)
+    {
+        multiply(x.data(), odd_powers.data(), odd_powers.data(), scratch.data());
+        for(size_t i = 1; i < (size_t(1) << (k - 1)); i++)
+            multiply(odd_powers.data() + i * n, odd_powers.data() + (i - 1) * n, x.data(), 
+                     scratch.data());
+    }
+
+    // the top window starts the result, then every bit squares it and every window 
+    // multiplies by its odd power
+    uint64_t value;
+    size_t i = top + 1 - exponent_window(exponent.data(), top, k, value);
+    limb_vector result(n);
+    copy(odd_powers.data() + (value >> 1) * n, odd_powers.data() + (value >> 1) * n + n, 
+         result.data());
+    uint64_t* r = result.data();
+    while(i > 0)
+    {
+        if(not limbs_bit(exponent.data(), i - 1))
+        {
+            multiply(r, r, r, scratch.data());
+            i--;
+            continue;
+        }
+        size_t length = exponent_window(exponent.data(), i - 1, k, value);
+        for(size_t j = 0; j < length; j++)
+            multiply(r, r, r, scratch.data());
+        multiply(r, r, odd_powers.data() + (value >> 1) * n, scratch.data());
+        i -= length;
+    }
+
+    // a Montgomery product with 1 leaves the Montgomery form
+    fill(x.begin(), x.end(), 0);
+    x[0] = 1;
+    multiply(r, r, x.data(), scratch.data());
+    normalize_limbs(result);
+    return result;
+}
+
+/**
+ * @brief base^exponent mod an odd modulus prepared for Montgomery multiplication. the 
+ * result is in [0, modulus), a negative base is reduced to its residue first
+ * 
+ * @param base 
+ * @param exponent throws if it's negative
+ * @param modulus 
+ * @return BigInt 
+ */
+BigInt powmod(const BigInt& base, const BigInt& exponent, const BigIntMontgomery& modulus)
+{
+    if(exponent.sign == '-')
+        throw invalid_argument("Negative exponent!");
+
+    const limb_vector& m = modulus.modulus.limbs;
+    limb_vector reduced = base.limbs;
+    if(compare_abs_values(reduced, m) >= 0)
+        reduced = get<1>(positive_divmod(reduced, m));
+    if(base.sign == '-' and not reduced.empty())
+    {
+        limb_vector residue = m;
+        positive_subtract_in_place(residue, reduced);
+        reduced = residue;
+    }
+
+    BigInt result;
+    result.limbs = modulus.power(reduced, exponent.limbs);
+    return result;
+}
+
+/**
+ * @brief base^exponent mod modulus, in [0, |modulus|). odd moduli use Montgomery 
+ * multiplication. an even modulus 2^t q is split into its odd part q, done the same way, 
+ * and 2^t, where products are simply truncated, and the two results are joined by the 
+ * Chinese remainder theorem
+ * 
+ * @param base 
+ * @param exponent throws if it's negative
+ * @param modulus throws if it's zero
+ * @return BigInt 
+ */
+BigInt powmod(const BigInt& base, const BigInt& exponent, const BigInt& modulus)
+{
+    const limb_vector& m = modulus.limbs;
+    if(m.empty())
+        throw invalid_argument("Division by zero!");
+    if(m[0] % 2 == 1)
+        return powmod(base, exponent, BigIntMontgomery(modulus));
+    if(exponent.sign == '-')
+        throw invalid_argument("Negative exponent!");
+
+    size_t zero_limbs = 0;
+    while(m[zero_limbs] == 0)
+        zero_limbs++;
+    unsigned shift = __builtin_ctzll(m[zero_limbs]);
+    size_t t = 64 * zero_limbs + shift;
+    BigInt odd_part;
+    odd_part.limbs.resize(m.size() - zero_limbs);
+    copy(m.begin() + zero_limbs, m.end(), odd_part.limbs.begin());
+    if(shift != 0)
+        limbs_rshift(odd_part.limbs.data(), odd_part.limbs.data(), odd_part.limbs.size(), shift);
+    normalize_limbs(odd_part.limbs);
+
+    BigInt odd_result = powmod(base, exponent, BigIntMontgomery(odd_part));
+    limb_vector power_of_2_result = power_mod_power_of_2(base.limbs, exponent.limbs, t);
+    if(base.sign == '-' and not exponent.limbs.empty() and exponent.limbs[0] % 2 == 1)
+        power_of_2_result = subtract_mod_power_of_2(limb_vector(), power_of_2_result, t);
+
+    // result = odd_result + q h, with h = (power_of_2_result - odd_result) q^-1 mod 2^t
+    limb_vector h = subtract_mod_power_of_2(power_of_2_result, odd_result.limbs, t);
+    h = positive_multiply(h, inverse_mod_power_of_2(odd_part.limbs, t));
+    truncate_bits(h, t);
+    BigInt result;
+    result.limbs = positive_multiply(odd_part.limbs, h);
+    positive_add_in_place(result.limbs, odd_result.limbs);
+    return result;
+}
+
+/**********************************************************************
+************************* BARRETT REDUCTION ***************************
+**********************************************************************/
+
+/**
+ * @brief prepares a modulus for Barrett reduction, floor(β^2n / m) is the only 
+ * division it ever does
+ * 
+ * @param other the modulus, throws if it's zero. its sign is ignored
+ */
+BigIntModContext::BigIntModContext(const BigInt& other)
+{
+    const limb_vector& limbs = other.get_limbs();
+    if(limbs.empty())
+        throw invalid_argument("Division by zero!");
+
+    modulus = other.get_sign() == '-' ? -other : other;
+    limb_vector power(2 * limbs.size() + 1);
+    power.back() = 1;
+    mu = get<0>(positive_divmod(power, limbs));
+}
+
+/**
+ * @brief get the modulus of a BigIntModContext object
+ * 
+ * @return const BigInt& 
+ */
+const BigInt& BigIntModContext::get_modulus() const
+{
+    return modulus;
+}
+
+/**
+ * @brief reduces x modulo the prepared modulus in place. values of up to 2n limbs take 
+ * one Barrett reduction, longer ones are folded from the top, 2n limbs at a time, each 
+ * fold removing n limbs. a negative x gets the residue in [0, modulus) too
+ * 
+ * @param x 
+ */
+void BigIntModContext::reduce(BigInt& x) const
+{
+    const limb_vector& m = modulus.limbs;
+    size_t n = m.size();
+    limb_vector& limbs = x.limbs;
+    if(compare_abs_values(limbs, m) >= 0)
+    {
+        limb_vector scratch(barrett_scratch_size(n));
+        while(limbs.size() > 2 * n)
+        {
+            uint64_t* window = limbs.data() + limbs.size() - 2 * n;
+            limbs_barrett_reduce(window, window, 2 * n, m.data(), n, mu.data(), mu.size(), 
+                                 scratch.data());
+            limbs.resize(limbs.size() - n);
+        }
+        normalize_limbs(limbs);
+        if(limbs.size() >= n)
+        {
+            limbs_barrett_reduce(limbs.data(), limbs.data(), limbs.size(), m.data(), n, 
+                                 mu.data(), mu.size(), scratch.data());
+            limbs.resize(n);
+            normalize_limbs(limbs);
+        }
+    }
+
+    if(x.sign == '-' and not limbs.empty())
+    {
+        limb_vector residue = m;
+        positive_subtract_in_place(residue, limbs);
+        limbs = residue;
+    }
+    x.sign = '+';
+}
+
+/**********************************************************************
+******************************* ROOTS *********************************
+**********************************************************************/
+
+/**
+ * @brief floor of the square root of a BigInt object
+ * 
+ * @param x throws if it's negative
+ * @return BigInt 
+ */
+BigInt isqrt(const BigInt& x)
+{
+    if(x.sign == '-')
+        throw invalid_argument("Square root of a negative number!");
+
+    BigInt result;
+    result.limbs = positive_root(x.limbs, 2);
+    return result;
+}
+
+/**
+ * @brief k-th root of a BigInt object, truncated toward zero like the quotient of /
+ * 
+ * @param x throws if it's negative and k is even
+ * @param k throws if it's zero
+ * @return BigInt 
+ */
+BigInt iroot(const BigInt& x, uint64_t k)
+{
+    if(k == 0)
+        throw invalid_argument("Zeroth root!");
+    if(x.sign == '-' and k % 2 == 0)
+        throw invalid_argument("Even root of a negative number!");
+
+    if(k == 1)
+        return x;
+    BigInt result;
+    result.limbs = positive_root(x.limbs, k);
+    result.sign = x.sign;
+    return result;
+}
+
+/**
+ * @brief checks if a BigInt object is a perfect square. squares are only a small part of 
+ * the residues modulo 64, 63, 65 and 11, so all but about 1 in 120 non-squares are 
+ * rejected by the low limb and one division by a single limb, without computing the root
+ * 
+ * @param x 
+ * @return true if x is the square of an integer
+ * @return false else, negative numbers included
+ */
+bool is_perfect_square(const BigInt& x)
+{
+    // bit r of mask is set if r is a square modulo m
+    static const uint64_t squares_mod_64 = 0x0202021202030213ULL;
+    static const uint64_t squares_mod_63 = 0x0402483012450293ULL;
+    static const uint64_t squares_mod_65[2] = {0x218a019866014613ULL, 0x1ULL};
+    static const uint64_t squares_mod_11 = 0x23bULL;
+
+    const limb_vector& limbs = x.limbs;
+    if(x.sign == '-')
+        return false;
+    if(limbs.empty())
+        return true;
+    if(((squares_mod_64 >> (limbs[0] % 64)) & 1) == 0)
+        return false;
+    // 45045 = 63 * 65 * 11
+    uint64_t residue = limbs_mod_1(limbs.data(), limbs.size(), 45045);
+    if(((squares_mod_63 >> (residue % 63)) & 1) == 0 or 
+       ((squares_mod_65[residue % 65 / 64] >> (residue % 65 % 64)) & 1) == 0 or 
+       ((squares_mod_11 >> (residue % 11)) & 1) == 0)
+        return false;
+
+    return positive_square(positive_root(limbs, 2)) == limbs;
+}
+
+/**********************************************************************
+********************* GREATEST COMMON DIVISOR *************************
+**********************************************************************/
+
+/*
+ * The Euclidean algorithm on a >= b is driven by 2x2 cofactor matrices N with 
+ * (a', b') = N (a, b). Below hgcd_threshold limbs, Lehmer's algorithm runs the Euclidean
+ * steps of the top two limbs of a and b, as long as Knuth's test shows their quotients are 
+ * also quotients of a and b, and applies the resulting single-limb matrix to a and b at 
+ * once. Larger operands use the half-GCD: the matrix that halves the top half of a and b 
+ * roughly halves a and b too, so it's computed recursively from the top halves, and 
+ * each halving costs a few multiplications. A matrix found from the top bits may be off 
+ * in its last steps, but any N with determinant +-1 keeps the gcd, so such a mistake is 
+ * repaired by fixing the signs and order of a' and b'.
+ */
+
+// operand size (in limbs) from which gcd and gcdext use the half-GCD instead of Lehmer's 
+// algorithm
+size_t hgcd_threshold = 100;
+
+/**
+ * @brief binary gcd of two words
+ * 
+ * @param a 
+ * @param b 
+ * @return uint64_t 
+ */
+uint64_t binary_gcd(uint64_t a, uint64_t b)
+{
+    if (a == 0 or b == 0)
+        return a | b;
+    unsigned shift = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    while (b != 0)
+    {
+        b >>= __builtin_ctzll(b);
+        if (a > b)
+            swap(a, b);
+        b -= a;
+    }
+    return a << shift;
+}
+
+/**
+ * @brief number of significant bits of a nonnegative 128-bit integer
+ * 
+ * @param x 
+ * @return size_t 
+ */
+size_t bit_length(unsigned __int128 x)
+{
+    uint64_t high = uint64_t(x >> 64);
+    if (high != 0)
+        return 128 - __builtin_clzll(high);
+    return uint64_t(x) == 0 ? 0 : 64 - __builtin_clzll(uint64_t(x));
+}
+
+/**
+ * @brief floor(limbs / 2^shift), for a result known to fit in 127 bits
+ * 
+ * @param limbs 
+ * @param shift 
+ * @return __int128 
+ */
+__int128 top_bits(const limb_vector& limbs, size_t shift)
+{
+    size_t first = shift / 64;
+    unsigned bits = shift % 64;
+    unsigned __int128 result = 0;
+    for (size_t i = min(first + 2, limbs.size()); i > first; i--)
+        result = (result << 64) | limbs[i - 1];
+    if (bits != 0 and first + 2 < limbs.size())
+        result = (result >> bits) | ((unsigned __int128)limbs[first + 2] << (128 - bits));
+    else
+        result >>= bits;
+    return __int128(result);
+}
+
+/**
+ * @brief one pass of Lehmer's algorithm (Knuth's Algorithm L) on a >= b: the Euclidean 
+ * steps of the top 126 bits of a and b (shifted by the same amount) are run on 128-bit 
+ * words, while Knuth's test shows each quotient is also a quotient of a and b and the 
+ * cofactors fit in 62 bits. numbers of at most 126 bits are exact, so no test is needed. 
+ * the pass stops after the first step that takes b to at most stop_bits bits
+ * 
+ * @param a 
+ * @param b 
+ * @param stop_bits 
+ * @param c receives the cofactors, a' = c[0][0] a + c[0][1] b and b' = c[1][0] a + c[1][1] b
+ * @return true if at least one step was taken
+ * @return false else, c[0][1] is then zero
+ */
+bool lehmer_pass(const limb_vector& a, const limb_vector& b, size_t stop_bits, int64_t c[2][2])
+{
+    const __int128 limit = __int128(1) << 62;
+    size_t bits = bit_length(a);
+    size_t shift = bits > 126 ? bits - 126 : 0;
+    __int128 x = top_bits(a, shift);
+    __int128 y = top_bits(b, shift);
+
+    __int128 A = 1, B = 0, C = 0, D = 1;
+    while (y != 0)
+    {
+        __int128 q;
+        if (shift == 0)
+            q = x / y;
+        else
+        {
+            // x + A .. x + B and y + C .. y + D bound a and b scaled down by 2^shift, the 
+            // quotient is certain if both ends agree
+            if (y + C <= 0 or y + D <= 0)
+                break;
+            q = (x + A) / (y + C);
+            if (q != (x + B) / (y + D))
+                break;
+        }
+        if (q >= limit)
+            break;
+        __int128 next_C = A - q * C;
+        __int128 next_D = B - q * D;
+        if (next_C >= limit or next_C <= -limit or next_D >= limit or next_D <= -limit)
+            break;
+        A = C;
+        B = D;
+        C = next_C;
+        D = next_D;
+        __int128 next_y = x - q * y;
+        x = y;
+        y = next_y;
+        if (bit_length((unsigned __int128)y) + shift <= stop_bits)
+            break;
+    }
+    c[0][0] = int64_t(A);
+    c[0][1] = int64_t(B);
+    c[1][0] = int64_t(C);
+    c[1][1] = int64_t(D);
+    return B != 0;
+}
+
+/**
+ * @brief x a + y b for word cofactors of opposite signs (or zero) whose result is known to 
+ * be nonnegative, as in a Lehmer step
+ * 
+ * @param a 
+ * @param b 
+ * @param x 
+ * @param y 
+ * @return limb_vector 
+ */
+limb_vector lehmer_combine(const limb_vector& a, const limb_vector& b, int64_t x, int64_t y)
+{
+    if (y > 0)
+        return lehmer_combine(b, a, y, x);
+
+    size_t n = max(a.size(), b.size());
+    limb_vector result(n + 1);
+    copy(a.begin(), a.end(), result.begin());
+    result[n] = limbs_mul_1(result.data(), result.data(), n, uint64_t(x));
+    if (y != 0 and not b.empty())
+        limbs_sub_1(result.data() + b.size(), result.data() + b.size(), n + 1 - b.size(), 
+                    limbs_submul_1(result.data(), b.data(), b.size(), int64_magnitude(y)));
+    normalize_limbs(result);
+    return result;
+}
+
+/**
+ * @brief an entry of a cofactor matrix, as a magnitude and a sign
+ * 
+ */
+struct cofactor
+{
+    limb_vector limbs;
+    bool negative;
+};
+
+/**
+ * @brief p x + q y for cofactors, zero is never negative
+ * 
+ * @param p 
+ * @param x 
+ * @param q 
+ * @param y 
+ * @return cofactor 
+ */
+cofactor cofactor_multiply_add(const cofactor& p, const cofactor& x, const cofactor& q, 
+                               const cofactor& y)
+{
+    cofactor result = {positive_multiply(p.limbs, x.limbs), p.negative != x.negative};
+    limb_vector other = positive_multiply(q.limbs, y.limbs);
+    if ((q.negative != y.negative) == result.negative)
+        positive_add_in_place(result.limbs, other);
+    else if (positive_subtract_in_place(result.limbs, other))
+        result.negative = not result.negative;
+    result.negative = result.negative and not result.limbs.empty();
+    return result;
+}
+
+/**
+ * @brief sets a cofactor matrix to the identity
+ * 
+ * @param N 
+ */
+void set_identity(cofactor (*N)[2])
+{
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 2; j++)
+            N[i][j] = {i == j ? limb_vector(1, 1) : limb_vector(), false};
+}
+
+/**
+ * @brief the row operation of a Euclidean step on a cofactor matrix, 
+ * (row 0, row 1) = (x row 0 + y row 1, z row 0 + w row 1)
+ * 
+ * @param N 
+ * @param x 
+ * @param y 
+ * @param z 
+ * @param w 
+ */
+void combine_rows(cofactor (*N)[2], const cofactor& x, const cofactor& y, const cofactor& z, 
+                  const cofactor& w)
+{
+    for (int j = 0; j < 2; j++)
+    {
+        cofactor top = cofactor_multiply_add(N[0][j], x, N[1][j], y);
+        N[1][j] = cofactor_multiply_add(N[0][j], z, N[1][j], w);
+        N[0][j] = move(top);
+    }
+}
+
+/**
+ * @brief combine_rows for the word cofactors of a Lehmer pass, computed in place on the 
+ * limbs: each entry is one row of a single-limb multiply and one of a multiply-add or 
+ * multiply-subtract, and a negative result is negated in two's complement
+ * 
+ * @param N 
+ * @param c 
+ */
+void combine_word_rows(cofactor (*N)[2], const int64_t (*c)[2])
+{
+    limb_vector result;
+    for (int j = 0; j < 2; j++)
+    {
+        cofactor rows[2];
+        for (int i = 0; i < 2; i++)
+        {
+            const cofactor& p = N[0][j];
+            const cofactor& q = N[1][j];
+            uint64_t x = int64_magnitude(c[i][0]);
+            uint64_t y = int64_magnitude(c[i][1]);
+            bool p_negative = p.negative != (c[i][0] < 0);
+            bool q_negative = q.negative != (c[i][1] < 0);
+            size_t n = max(p.limbs.size(), q.limbs.size());
+            result.resize(n + 1);
+            fill(result.begin(), result.end(), 0);
+            if (not p.limbs.empty())
+                result[p.limbs.size()] = limbs_mul_1(result.data(), p.limbs.data(), 
+                                                     p.limbs.size(), x);
+            bool negative = p_negative;
+            if (not q.limbs.empty() and q_negative == p_negative)
+                limbs_add_1(result.data() + q.limbs.size(), result.data() + q.limbs.size(), 
+                            n + 1 - q.limbs.size(), 
+                            limbs_addmul_1(result.data(), q.limbs.data(), q.limbs.size(), y));
+            else if (not q.limbs.empty())
+            {
+                uint64_t borrow = limbs_submul_1(result.data(), q.limbs.data(), q.limbs.size(), y);
+                if (limbs_sub_1(result.data() + q.limbs.size(), result.data() + q.limbs.size(), 
+                                n + 1 - q.limbs.size(), borrow) != 0)
+                {
+                    tc_negate(result.data(), n + 1);
+                    negative = not negative;
+                }
+            }
+            normalize_limbs(result);
+            swap(rows[i].limbs, result);
+            rows[i].negative = negative and not rows[i].limbs.empty();
+        }
+        swap(N[0][j], rows[0]);
+        swap(N[1][j], rows[1]);
+    }
+}
+
+/**
+ * @brief Euclidean steps on a >= b until b has at most stop_bits bits, by Lehmer passes, 
+ * or a division when a pass can't take a step. the steps are also applied to the rows of 
+ * N, unless it's null
+ * 
+ * @param a 
+ * @param b 
+ * @param stop_bits 
+ * @param N 
+ */
+void lehmer_reduce(limb_vector& a, limb_vector& b, size_t stop_bits, cofactor (*N)[2])
+{
+    int64_t c[2][2];
+    while (bit_length(b) > stop_bits)
+    {
+        if (lehmer_pass(a, b, stop_bits, c))
+        {
+            limb_vector next_b = lehmer_combine(a, b, c[1][0], c[1][1]);
+            a = lehmer_combine(a, b, c[0][0], c[0][1]);
+            b = next_b;
+            if (N != nullptr)
+                combine_word_rows(N, c);
+        }
+        else
+        {
+            cofactor quotient = {limb_vector(), true};
+            tie(quotient.limbs, a) = positive_divmod(a, b);
+            swap(a, b);
+            if (N != nullptr)
+            {
+                cofactor zero = {limb_vector(), false};
+                cofactor one = {limb_vector(1, 1), false};
+                combine_rows(N, zero, one, one, quotient);
+            }
+        }
+    }
+}
+
+/**
+ * @brief replaces (a, b) by N (a, b), given the values N already gave for the top bits, 
+ * top = N (a >> shift, b >> shift): then N (a, b) = top << shift + N (low bits), so only 
+ * the low bits are multiplied. the rows of N that gave a negative value are negated, 
+ * and swapped if needed, so that a >= b >= 0 again
+ * 
+ * @param N 
+ * @param a 
+ * @param b 
+ * @param shift 
+ * @param top_a 
+ * @param top_b 
+ */
+void apply_cofactors(cofactor (*N)[2], limb_vector& a, limb_vector& b, size_t shift, 
+                     const limb_vector& top_a, const limb_vector& top_b)
+{
+    truncate_bits(a, shift);
+    truncate_bits(b, shift);
+    limb_vector values[2];
+    for (int i = 0; i < 2; i++)
+    {
+        limb_vector low = positive_multiply(N[i][0].limbs, a);
+        bool negative = N[i][0].negative;
+        limb_vector other = positive_multiply(N[i][1].limbs, b);
+        if (N[i][1].negative == negative)
+            positive_add_in_place(low, other);
+        else if (positive_subtract_in_place(low, other))
+            negative = not negative;
+
+        values[i] = shift_left_bits(i == 0 ? top_a : top_b, shift);
+        if (not negative)
+            positive_add_in_place(values[i], low);
+        else if (positive_subtract_in_place(values[i], low))
+        {
+            N[i][0].negative = not N[i][0].negative and not N[i][0].limbs.empty();
+            N[i][1].negative = not N[i][1].negative and not N[i][1].limbs.empty();
+        }
+    }
+    if (compare_abs_values(values[0], values[1]) < 0)
+    {
+        swap(values[0], values[1]);
+        swap(N[0][0], N[1][0]);
+        swap(N[0][1], N[1][1]);
+    }
+    a = values[0];
+    b = values[1];
+}
+
+/**
+ * @brief the half-GCD: Euclidean steps on a >= b of n bits until b has at most n / 2 + 1 
+ * bits, collected in N (unless it's null). the top n / 2 bits of a and b are reduced 
+ * recursively first, which takes a and b down to about 3n / 4 bits, then after one 
+ * division the top bits of what's left are reduced recursively again. Lehmer steps finish 
+ * the few remaining steps
+ * 
+ * @param a 
+ * @param b 
+ * @param N 
+ */
+void half_gcd(limb_vector& a, limb_vector& b, cofactor (*N)[2])
+{
+    if (N != nullptr)
+        set_identity(N);
+    size_t n = bit_length(a);
+    size_t s = n / 2 + 1;
+    if (a.size() < hgcd_threshold)
+    {
+        lehmer_reduce(a, b, s, N);
+        return;
+    }
+
+    cofactor M[2][2];
+    for (int half = 0; half < 2 and bit_length(b) > s; half++)
+    {
+        // the top bits are chosen so that their half-GCD leaves about s bits in a and b: 
+        // first the top half, then twice as many bits as a has above s
+        size_t m = bit_length(a);
+        if (half == 1 and 2 * (m - s) >= n)
+            break;
+        size_t shift = half == 0 ? n / 2 : 2 * s - m;
+        limb_vector top_a = shift_right_bits(a, shift);
+        limb_vector top_b = shift_right_bits(b, shift);
+        half_gcd(top_a, top_b, M);
+        apply_cofactors(M, a, b, shift, top_a, top_b);
+        if (N != nullptr)
+            combine_rows(N, M[0][0], M[0][1], M[1][0], M[1][1]);
+
+        if (half == 0 and bit_length(b) > s)
+            lehmer_reduce(a, b, bit_length(b) - 1, N);
+    }
+    lehmer_reduce(a, b, s, N);
+}
+
+/**
+ * @brief Euclidean steps on a >= b until b is zero, a is then the gcd. the steps are 
+ * collected in N, unless it's null: the half-GCD halves a and b while they're long, then 
+ * Lehmer passes take over. without N, the last word is done by the binary gcd
+ * 
+ * @param a 
+ * @param b 
+ * @param N 
+ */
+void gcd_reduce(limb_vector& a, limb_vector& b, cofactor (*N)[2])
+{
+    cofactor M[2][2];
+    while (b.size() >= hgcd_threshold)
+    {
+        // the half-GCD has nothing to do if b is already half as long as a, a division 
+        // does it then
+        if (bit_length(b) <= bit_length(a) / 2 + 1)
+        {
+            lehmer_reduce(a, b, bit_length(b) - 1, N);
+            continue;
+        }
+        half_gcd(a, b, N != nullptr ? M : nullptr);
+        if (N != nullptr)
+            combine_rows(N, M[0][0], M[0][1], M[1][0], M[1][1]);
+    }
+
+    if (N != nullptr)
+    {
+        lehmer_reduce(a, b, 0, N);
+        return;
+    }
+    lehmer_reduce(a, b, 64, nullptr);
+    if (not b.empty())
+    {
+        a = limb_vector(1, binary_gcd(b[0], limbs_mod_1(a.data(), a.size(), b[0])));
+        b.clear();
+    }
+}
+
+/**
+ * @brief greatest common divisor of two BigInt objects, always nonnegative. gcd(0, 0) is 0
+ * 
+ * @param a 
+ * @param b 
+ * @return BigInt 
+ */
+BigInt gcd(const BigInt& a, const BigInt& b)
+{
+    limb_vector x = a.limbs;
+    limb_vector y = b.limbs;
+    if (compare_abs_values(x, y) < 0)
+        swap(x, y);
+    gcd_reduce(x, y, nullptr);
+
+    BigInt result;
+    result.limbs = x;
+    return result;
+}
+
+/**
+ * @brief greatest common divisor of a BigInt object and a 64-bit integer, always 
+ * nonnegative: one pass for the remainder by the word, then the binary gcd of two words
+ * 
+ * @param a 
+ * @param b 
+ * @return BigInt 
+ */
+BigInt gcd(const BigInt& a, int64_t b)
+{
+    uint64_t word = int64_magnitude(b);
+    if (word == 0)
+        return a.sign == '-' ? -a : a;
+
+    BigInt result;
+    if (a.limbs.empty())
+        result.assign_magnitude(word, 0);
+    else
+        result.assign_magnitude(binary_gcd(word, limbs_mod_1(a.limbs.data(), a.limbs.size(), word)), 0);
+    return result;
+}
+
+/**
+ * @brief greatest common divisor of a 64-bit integer and a BigInt object, always nonnegative
+ * 
+ * @param a 
+ * @param b 
+ * @return BigInt 
+ */
+BigInt gcd(int64_t a, const BigInt& b)
+{
+    return gcd(b, a);
+}
+
+/**
+ * @brief least common multiple of two BigInt objects, always nonnegative. it's 0 if 
+ * either of them is 0
+ * 
+ * @param a 
+ * @param b 
+ * @return BigInt 
+ */
+BigInt lcm(const BigInt& a, const BigInt& b)
+{
+    if (a == 0 or b == 0)
+        return BigInt();
+    BigInt result = a / gcd(a, b) * b;
+    return result.get_sign() == '-' ? -result : result;
+}
+
+/**
+ * @brief least common multiple of a BigInt object and a 64-bit integer, always 
+ * nonnegative. it's 0 if either of them is 0
+ * 
+ * @param a 
+ * @param b 
+ * @return BigInt 
+ */
+BigInt lcm(const BigInt& a, int64_t b)
+{
+    if (a == 0 or b == 0)
+        return BigInt();
+    BigInt result = a / gcd(a, b) * b;
+    return result.get_sign() == '-' ? -result : result;
+}
+
+/**
+ * @brief least common multiple of a 64-bit integer and a BigInt object, always nonnegative
+ * 
+ * @param a 
+ * @param b 
+ * @return BigInt 
+ */
+BigInt lcm(int64_t a, const BigInt& b)
+{
+    return lcm(b, a);
+}
+
+/**
+ * @brief extended gcd of two BigInt objects: g = gcd(a, b) and s, t such that 
+ * s a + t b = g. s is brought into (-|b| / 2g, |b| / 2g], which also makes |t| <= |a| / 2g 
+ * (up to one when |a| or |b| is g), so the result doesn't depend on the algorithm
+ * 
+ * @param a 
+ * @param b 
+ * @return tuple<BigInt, BigInt, BigInt>:: g, s and t
+ */
+tuple<BigInt, BigInt, BigInt> gcdext(const BigInt& a, const BigInt& b)
+{
+    bool swapped = compare_abs_values(a.limbs, b.limbs) < 0;
+    limb_vector x = swapped ? b.limbs : a.limbs;
+    limb_vector y = swapped ? a.limbs : b.limbs;
+    cofactor N[2][2];
+    set_identity(N);
+    gcd_reduce(x, y, N);
+
+    BigInt g;
+    g.limbs = x;
+    if (g.limbs.empty())
+        return make_tuple(move(g), BigInt(), BigInt());
+    BigInt s, t;
+    s.limbs = move(N[0][swapped ? 1 : 0].limbs);
+    t.limbs = move(N[0][swapped ? 0 : 1].limbs);
+    bool s_negative = N[0][swapped ? 1 : 0].negative != (a.sign == '-');
+    bool t_negative = N[0][swapped ? 0 : 1].negative != (b.sign == '-');
+    s.sign = s_negative and not s.limbs.empty() ? '-' : '+';
+    t.sign = t_negative and not t.limbs.empty() ? '-' : '+';
+
+    if (not b.limbs.empty())
+    {
+        // s' = s - k m and t' = t + k a / b m, with m = |b| / g
+        BigInt m = b.sign == '-' ? -b / g : b / g;
+        BigInt reduced = s % m;
+        if (reduced < 0)
+            reduced += m;
+        if (reduced * 2 > m)
+            reduced -= m;
+        BigInt k = (s - reduced) / m;
+        s = reduced;
+        t += b.sign == '-' ? -k * (a / g) : k * (a / g);
     }
-    if(carry != 0)
-        sum += to_string(carry);
+    return make_tuple(move(g), move(s), move(t));
+}
 
-    // sum is reversed, so reversing it back
-    reverse(sum.begin(), sum.end());
-    return sum;
+/**
+ * @brief inverse of a modulo m, in [0, |m|)
+ * 
+ * @param a throws if it's not coprime to m
+ * @param modulus throws if it's zero
+ * @return BigInt:: x such that a x = 1 mod m
+ */
+BigInt invert(const BigInt& a, const BigInt& modulus)
+{
+    if (modulus == 0)
+        throw invalid_argument("Division by zero!");
+
+    BigInt m = modulus.get_sign() == '-' ? -modulus : modulus;
+    BigInt reduced = a % m;
+    if (reduced < 0)
+        reduced += m;
+    BigInt g, s, t;
+    tie(g, s, t) = gcdext(reduced, m);
+    if (g != 1)
+        throw invalid_argument("Not invertible!");
+    return s < 0 ? s + m : s;
+}
+
+/**********************************************************************
+*************************** COMBINATORICS *****************************
+**********************************************************************/
+
+/*
+ * Products of many small factors are never built one factor at a time, which would 
+ * multiply a huge running product by one word at each step. The factors are collected 
+ * (as prime powers where possible) and multiplied by a balanced product tree instead.
+ */
+
+/**
+ * @brief the odd part of the swinging factorial n! / (n/2)!^2 (Luschny), the product 
+ * of p^e over the odd primes p <= n, where e counts the odd numbers among 
+ * floor(n / p^i). every such p^e is at most n
+ * 
+ * @param n 
+ * @param primes the primes up to at least n
+ * @return limb_vector 
+ */
+limb_vector odd_swing(uint64_t n, const vector<uint64_t>& primes)
+{
+    vector<uint64_t> factors;
+    for (size_t i = 1; i < primes.size() and primes[i] <= n; i++)
+    {
+        uint64_t p = primes[i];
+        uint64_t power = 1;
+        for (uint64_t q = n / p; q > 0; q /= p)
+            if (q % 2 == 1)
+                power *= p;
+        if (power > 1)
+            factors.push_back(power);
+    }
+    return word_product(factors);
 }
 
 /**
- * @brief subtract two large numbers represented as strings. 
- * For correct results str1 should represent a larger number than what str2 represents
+ * @brief product of a list of BigInt objects by a balanced product tree. the product 
+ * of an empty list is 1
  * 
- * @param str1 
- * @param str2 
- * @return string:: subtract result
+ * @param factors 
+ * @return BigInt 
  */
-string positive_subtract(const string& str1, const string& str2)
+BigInt product(const vector<BigInt>& factors)
 {
-    // create a vector and push back the first input as in int in reverse (for easier subtraction)
-    vector<int64_t> str1_v;
-    for (size_t i = str1.size(); i >= 1; i--)
-        str1_v.push_back(str1[i - 1] - '0');
-    
-    // create a vector and push back the second input as in int in reverse (for easier subtraction)
-    vector<int64_t> str2_v;
-    for (size_t i = str2.size(); i >= 1; i--)
-        str2_v.push_back(str2[i - 1] - '0');
+    BigInt result = 1;
+    if (factors.empty())
+        return result;
+
+    vector<limb_vector> level;
+    bool negative = false;
+    for (size_t i = 0; i < factors.size(); i++)
+    {
+        if (factors[i].limbs.empty())
+            return BigInt();
+        level.push_back(factors[i].limbs);
+        negative = negative != (factors[i].sign == '-');
+    }
+    while (level.size() > 1)
+    {
+        for (size_t i = 0; i + 1 < level.size(); i += 2)
+            level[i / 2] = positive_multiply(level[i], level[i + 1]);
+        if (level.size() % 2 == 1)
+            level[level.size() / 2] = level.back();
+        level.resize((level.size() + 1) / 2);
+    }
+    result.limbs = level[0];
+    result.sign = negative ? '-' : '+';
+    return result;
+}
 
-    // add 0 padding to the smaller one
-    while (str1_v.size() < str2_v.size()) 
-        str1_v.push_back(0);
-    while (str2_v.size() < str1_v.size()) 
-        str2_v.push_back(0);
+/**
+ * @brief n! by the prime swing algorithm: the odd part of n! is the square of the odd 
+ * part of (n/2)! times the odd part of the swinging factorial of n, and n! has 
+ * n - popcount(n) factors of 2, added as one shift at the end
+ * 
+ * @param n 
+ * @return BigInt 
+ */
+BigInt factorial(uint64_t n)
+{
+    vector<uint64_t> primes = primes_up_to(n);
+    vector<uint64_t> halvings;
+    for (uint64_t m = n; m > 1; m /= 2)
+        halvings.push_back(m);
 
-    vector<int64_t> result;
-    string sub;
-    // subtraction loop
-    for (size_t i = 0; i < str1_v.size(); i++)
+    limb_vector odd_part(1, 1);
+    for (size_t i = halvings.size(); i > 0; i--)
     {
-        int64_t up_num = str1_v[i];
-        int64_t down_num = str2_v[i];
-        
-        if (up_num < down_num)
-        {
-            up_num += 10;
-            str1_v[i + 1] -= 1;
-        }
-        result.push_back(up_num - down_num);
-        sub += to_string(up_num - down_num);
+        odd_part = positive_square(odd_part);
+        odd_part = positive_multiply(odd_part, odd_swing(halvings[i - 1], primes));
     }
 
-    // sub is reversed, so reversing it back
-    reverse(sub.begin(), sub.end());
-    return remove_left_zeros(sub);
+    BigInt result;
+    result.limbs = shift_left_bits(odd_part, n - __builtin_popcountll(n));
+    return result;
 }
 
 /**
- * @brief sum two large numbers represented as strings, without signs
+ * @brief the binomial coefficient C(n, k), 0 if k > n. a k small against n takes the 
+ * product of n - k + 1 .. n divided by k!. otherwise C(n, k) is the product of p^e over 
+ * the primes p <= n, where by Kummer's theorem e is the number of borrows when 
+ * subtracting k from n in base p. every such p^e is at most n
  * 
- * @param str1 
- * @param str2 
- * @return string:: product result
+ * @param n 
+ * @param k 
+ * @return BigInt 
  */
-string positive_multiply(const string& str1, const string& str2)
+BigInt binomial(uint64_t n, uint64_t k)
 {
-    // create a vector and push back the first input as in int 
-    // in reverse (for easier multiplication)
-    vector<int64_t> str1_v;
-    for (size_t i = str1.size(); i >= 1; i--)
-        str1_v.push_back(str1[i - 1] - '0');
+    BigInt result;
+    if (k > n)
+        return result;
+    k = min(k, n - k);
 
-    // create a vector and push back the second input as in int in 
-    // reverse (for easier multiplication)
-    vector<int64_t> str2_v;
-    for (size_t i = str2.size(); i >= 1; i--)
-        str2_v.push_back(str2[i - 1] - '0');
+    vector<uint64_t> factors;
+    if (k < n / 16)
+    {
+        for (uint64_t i = 0; i < k; i++)
+            factors.push_back(n - i);
+        result.limbs = get<0>(positive_divmod(word_product(factors), factorial(k).limbs));
+        return result;
+    }
 
-    // product is the final vector result (m-digit * n-digit has at most (m + n) digits)
-    vector<int64_t> product(str1_v.size() + str2_v.size(), 0);
-    
-    // multiplication loop
-    for (size_t i = 0; i < str1_v.size(); i++)
+    vector<uint64_t> primes = primes_up_to(n);
+    for (size_t i = 0; i < primes.size(); i++)
     {
-        for (size_t j = 0; j < str2_v.size(); ++j)
+        uint64_t p = primes[i];
+        uint64_t power = 1;
+        uint64_t borrow = 0;
+        for (uint64_t a = n, b = k; a > 0; a /= p, b /= p)
         {
-            product[i + j] += str1_v[i] * str2_v[j];
-            if (product[i + j] >= 10) {
-                product[i + j + 1] += product[i + j] / 10;
-                product[i + j] %= 10;
-            }
+            borrow = a % p < b % p + borrow ? 1 : 0;
+            if (borrow)
+                power *= p;
         }
+        if (power > 1)
+            factors.push_back(power);
     }
-    
-    // create string version of product
-    string product_str;
-    for (size_t i = product.size(); i >= 1; i--)
-    {
-        product_str += to_string(product[i - 1]);
-    }
-
-    // remove zeros in the beginning
-    return remove_left_zeros(product_str);
+    result.limbs = word_product(factors);
+    return result;
 }
 
 /**
- * @brief checks if the first abs_value is greater than the second
+ * @brief the primorial n#, the product of the primes up to n
  * 
- * @param str1 
- * @param str2 
- * @return true abs_val1 > abs_val2
- * @return false abs_val2 >= abs_val1
+ * @param n 
+ * @return BigInt 
  */
-bool is_first_abs_value_greater(const string& abs_val1, const string& abs_val2)
+BigInt primorial(uint64_t n)
 {
-    if(abs_val1.length() == abs_val2.length())
-        return abs_val1 > abs_val2;
-    else
-        return abs_val1.length() > abs_val2.length() ? true : false;
+    BigInt result;
+    result.limbs = word_product(primes_up_to(n));
+    return result;
 }
 
 /**********************************************************************
-************************** MEMBER FUNCTIONS ***************************
+***************************** PRIMALITY *******************************
 **********************************************************************/
 
+/*
+ * is_probable_prime first divides by the primes up to SMALL_PRIME_BOUND at once, as the 
+ * gcd of n mod their product with the product. the Baillie-PSW test then runs a strong 
+ * Miller-Rabin test to base 2 and a strong Lucas test with Selfridge's parameters: no 
+ * composite is known to pass both, and none exists below 2^64. the modular powers use 
+ * Montgomery multiplication, the remaining squarings and the Lucas sequences Barrett 
+ * reduction.
+ */
+
+// the primes up to this bound are tried by trial division
+const uint64_t SMALL_PRIME_BOUND = 1000;
+
 /**
- * @brief get sign of a BigInt object
+ * @brief Jacobi symbol (a / n) of words, for odd n
  * 
- * @return char 
+ * @param a 
+ * @param n 
+ * @return int:: -1, 0 or 1
  */
-char BigInt::get_sign() const
+int jacobi(uint64_t a, uint64_t n)
 {
-    return sign;
+    int result = 1;
+    a %= n;
+    while (a != 0)
+    {
+        // (2 / n) is -1 for n = 3 or 5 mod 8
+        unsigned twos = __builtin_ctzll(a);
+        a >>= twos;
+        if (twos % 2 == 1 and (n % 8 == 3 or n % 8 == 5))
+            result = -result;
+        // quadratic reciprocity, (a / n) = -(n / a) if both are 3 mod 4
+        swap(a, n);
+        if (a % 4 == 3 and n % 4 == 3)
+            result = -result;
+        a %= n;
+    }
+    return n == 1 ? result : 0;
 }
 
 /**
- * @brief get absolute value of a BigInt object
+ * @brief Jacobi symbol (d / n) of a small d and an odd positive BigInt n
  * 
- * @return char 
+ * @param d 
+ * @param n 
+ * @return int:: -1, 0 or 1
  */
-string BigInt::get_abs_value() const
+int jacobi(int64_t d, const BigInt& n)
 {
-    return abs_value;
+    const limb_vector& limbs = n.get_limbs();
+    uint64_t magnitude = int64_magnitude(d);
+    // (-1 / n) is -1 for n = 3 mod 4
+    int result = d < 0 and limbs[0] % 4 == 3 ? -1 : 1;
+    unsigned twos = __builtin_ctzll(magnitude);
+    magnitude >>= twos;
+    if (twos % 2 == 1 and (limbs[0] % 8 == 3 or limbs[0] % 8 == 5))
+        result = -result;
+    // quadratic reciprocity turns (magnitude / n) into (n mod magnitude / magnitude)
+    if (magnitude % 4 == 3 and limbs[0] % 4 == 3)
+        result = -result;
+    return result * jacobi(limbs_mod_1(limbs.data(), limbs.size(), magnitude), magnitude);
 }
 
-/**********************************************************************
-*************************** CONSTRUCTORS ******************************
-**********************************************************************/
-
 /**
- * @brief Default Constructor of a new BigInt:: BigInt object
+ * @brief strong probable prime test to a base, for an odd n > 3 with n - 1 = d 2^s
  * 
+ * @param base 
+ * @param d 
+ * @param s 
+ * @param montgomery n prepared for Montgomery multiplication
+ * @param context n prepared for Barrett reduction
+ * @return true if n is a strong probable prime to base
+ * @return false if n is composite
  */
-BigInt::BigInt() 
+bool strong_probable_prime(const BigInt& base, const BigInt& d, size_t s, 
+                           const BigIntMontgomery& montgomery, const BigIntModContext& context)
 {
-    abs_value = "0";
-    sign = '+';
+    BigInt n_minus_1 = context.get_modulus() - 1;
+    BigInt x = powmod(base, d, montgomery);
+    if (x == 1 or x == n_minus_1)
+        return true;
+    for (size_t r = 1; r < s; r++)
+    {
+        x = x.square();
+        context.reduce(x);
+        if (x == n_minus_1)
+            return true;
+        if (x == 1)
+            return false;
+    }
+    return false;
 }
 
 /**
- * @brief Construct a new BigInt from 64-bit integer:: BigInt object
+ * @brief x / 2 mod n, for x in [0, n) and odd n
  * 
- * @param str is a 64-bit integer
+ * @param x 
+ * @param n 
  */
-BigInt::BigInt(const int64_t& number) 
+void halve_mod(BigInt& x, const BigInt& n)
 {
-    abs_value = to_string(abs(number));
-    if (number < 0)
-        sign = '-';
-    else
-        sign = '+';
+    if (x.get_limbs().empty())
+        return;
+    if (x.get_limbs()[0] % 2 == 1)
+        x += n;
+    x /= 2;
 }
 
 /**
- * @brief Construct a new BigInt from string:: BigInt object
+ * @brief strong Lucas probable prime test with P = 1 and Q = (1 - D) / 4, for an odd n 
+ * that isn't a square, with n + 1 = d 2^s and the Jacobi symbol (D / n) = -1. U_d and V_d 
+ * are computed by doubling along the bits of d, then V is doubled s - 1 more times
  * 
- * @param str is a string
+ * @param D 
+ * @param d 
+ * @param s 
+ * @param context n prepared for Barrett reduction
+ * @return true if n is a strong Lucas probable prime
+ * @return false if n is composite
  */
-BigInt::BigInt(const string& str) 
+bool strong_lucas_probable_prime(int64_t D, const BigInt& d, size_t s, 
+                                 const BigIntModContext& context)
 {
-
-    if(str[0] == '+' or str[0] == '-')
+    const BigInt& n = context.get_modulus();
+    BigInt Q = (1 - D) / 4;
+    BigInt U = 1;
+    BigInt V = 1;
+    BigInt Q_power = Q;
+    context.reduce(Q_power);
+    const limb_vector& bits = d.get_limbs();
+    for (size_t i = bit_length(bits) - 1; i > 0; i--)
     {
-        if(is_number(str.substr(1)))
-        {
-            abs_value = str.substr(1);
-            abs_value = remove_left_zeros(abs_value);
-            sign = abs_value == "0" ? '+' : '-' ;
-        }
-        else
+        // k -> 2k: U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+        U *= V;
+        context.reduce(U);
+        V = V.square() - 2 * Q_power;
+        context.reduce(V);
+        Q_power = Q_power.square();
+        context.reduce(Q_power);
+        if (limbs_bit(bits.data(), i - 1))
         {
-            throw invalid_argument(str + " is not a valid integer!");
+            // 2k -> 2k + 1: U' = (U + V) / 2, V' = (D U + V) / 2
+            BigInt next_U = U + V;
+            context.reduce(next_U);
+            halve_mod(next_U, n);
+            V += D * U;
+            context.reduce(V);
+            halve_mod(V, n);
+            U = next_U;
+            Q_power *= Q;
+            context.reduce(Q_power);
         }
     }
-    else
+
+    if (U == 0 or V == 0)
+        return true;
+    for (size_t r = 1; r < s; r++)
     {
-        if(is_number(str))
-        {
-            abs_value = str;
-            abs_value = remove_left_zeros(abs_value);
-            sign = '+';
-        }
-        else
-        {
-            throw invalid_argument(str + " is not a valid integer!");
-        }
+        V = V.square() - 2 * Q_power;
+        context.reduce(V);
+        if (V == 0)
+            return true;
+        Q_power = Q_power.square();
+        context.reduce(Q_power);
     }
-
+    return false;
 }
 
-/**********************************************************************
-*************************** ASSIGNMENT = ******************************
-**********************************************************************/
-
 /**
- * @brief assigning a previously defined 64-bit integer to a BigInt object
+ * @brief checks if a BigInt object is a probable prime by the Baillie-PSW test, after 
+ * trial division. the answer is exact below 2^64. rounds more Miller-Rabin tests to 
+ * pseudorandom bases (derived from n, so the answer doesn't change between runs) can be 
+ * added on top
  * 
- * @param number 
- * @return BigInt& 
+ * @param n numbers below 2 (negative ones included) aren't prime
+ * @param rounds 
+ * @return true if n is a probable prime
+ * @return false if n is composite
  */
-BigInt& BigInt::operator=(const int64_t& number) 
+bool is_probable_prime(const BigInt& n, size_t rounds)
 {
+    static const BigInt small_primes_product = primorial(SMALL_PRIME_BOUND);
+    if (n < 2)
+        return false;
+    if (n <= int64_t(SMALL_PRIME_BOUND))
+    {
+        vector<uint64_t> primes = primes_up_to(SMALL_PRIME_BOUND);
+        return binary_search(primes.begin(), primes.end(), n.limbs[0]);
+    }
+    if (gcd(n % small_primes_product, small_primes_product) != 1)
+        return false;
+    if (n < int64_t(SMALL_PRIME_BOUND * SMALL_PRIME_BOUND))
+        return true;
+
+    BigIntMontgomery montgomery(n);
+    BigIntModContext context(n);
+    // n - 1 = d 2^s
+    BigInt d = n - 1;
+    size_t s = 0;
+    while (not limbs_bit(d.limbs.data(), s))
+        s++;
+    d.limbs = shift_right_bits(d.limbs, s);
+    if (not strong_probable_prime(2, d, s, montgomery, context))
+        return false;
 
-    abs_value = to_string(abs(number));
-    if (number < 0)
-        sign = '-';
-    else
-        sign = '+';
+    // Selfridge's method: the first of 5, -7, 9, -11, ... with (D / n) = -1, which 
+    // doesn't exist if n is a square
+    if (is_perfect_square(n))
+        return false;
+    int64_t D = 5;
+    while (true)
+    {
+        int symbol = jacobi(D, n);
+        if (symbol == -1)
+            break;
+        if (symbol == 0 and n != (D < 0 ? -D : D))
+            return false;
+        D = D < 0 ? 2 - D : -2 - D;
+    }
+    // n + 1 = d 2^s
+    d = n + 1;
+    s = 0;
+    while (not limbs_bit(d.limbs.data(), s))
+        s++;
+    d.limbs = shift_right_bits(d.limbs, s);
+    if (not strong_lucas_probable_prime(D, d, s, context))
+        return false;
 
-    return *this;
+    // splitmix64 seeded by n gives the bases of the extra rounds, in [3, n - 2]
+    uint64_t state = n.limbs[0] ^ n.limbs.size();
+    d = n - 1;
+    s = 0;
+    while (not limbs_bit(d.limbs.data(), s))
+        s++;
+    d.limbs = shift_right_bits(d.limbs, s);
+    BigInt range = n - 4;
+    for (size_t round = 0; round < rounds; round++)
+    {
+        BigInt base;
+        base.limbs.resize(n.limbs.size());
+        for (size_t i = 0; i < base.limbs.size(); i++)
+        {
+            uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            base.limbs[i] = z ^ (z >> 31);
+        }
+        normalize_limbs(base.limbs);
+        base = base % range + 3;
+        if (not strong_probable_prime(base, d, s, montgomery, context))
+            return false;
+    }
+    return true;
 }
 
 /**
- * @brief assigning a previously defined string to a BigInt object
+ * @brief the smallest prime greater than a BigInt object. candidates are taken a window 
+ * at a time: the multiples of the small primes are crossed out of the window by a sieve, 
+ * from one remainder per prime, and only the candidates left go through 
+ * is_probable_prime
  * 
- * @param str 
- * @return BigInt& 
+ * @param n 
+ * @return BigInt 
  */
-BigInt& BigInt::operator=(const string& str) 
+BigInt next_prime(const BigInt& n)
 {
-    if(str[0] == '+' or str[0] == '-')
+    if (n < 2)
+        return 2;
+    size_t bits = bit_length(n.limbs);
+    if (bits <= 32)
     {
-        if(is_number(str.substr(1)))
-        {
-            abs_value = str.substr(1);
-            abs_value = remove_left_zeros(abs_value);
-            sign = abs_value == "0" ? '+' : '-' ;
-        }
-        else
-        {
-            throw invalid_argument(str + " is not a valid integer!");
-        }
+        BigInt candidate = n + 1;
+        while (not is_probable_prime(candidate, 0))
+            candidate += 1;
+        return candidate;
     }
-    else
+
+    // about 4 ln(n) candidates per window, sieved by primes up to 20 bits per bit of n, 
+    // all far below the candidates
+    size_t window = 3 * bits;
+    vector<uint64_t> primes = primes_up_to(min<uint64_t>(20 * bits, 1 << 20));
+    BigInt start = n + 1;
+    while (true)
     {
-        if(is_number(str))
+        vector<bool> composite(window);
+        for (size_t i = 0; i < primes.size(); i++)
         {
-            abs_value = str;
-            abs_value = remove_left_zeros(abs_value);
-            sign = '+';
+            uint64_t p = primes[i];
+            uint64_t remainder = limbs_mod_1(start.limbs.data(), start.limbs.size(), p);
+            for (uint64_t j = remainder == 0 ? 0 : p - remainder; j < window; j += p)
+                composite[j] = true;
         }
-        else
+        for (size_t i = 0; i < window; i++)
         {
-            throw invalid_argument(str + " is not a valid integer!");
+            if (composite[i])
+                continue;
+            BigInt candidate = start + int64_t(i);
+            if (is_probable_prime(candidate, 0))
+                return candidate;
         }
+        start += int64_t(window);
     }
-    return *this;
 }
 
 /**********************************************************************
-*********************** NEGATION (UNARY - +) **************************
+********************* VIEWS AND SERIALIZATION *************************
 **********************************************************************/
 
+/*
+ * the serialized form of a BigInt is a version byte, the number of limbs as a LEB128 
+ * varint, a sign byte (0 for +, 1 for -) and zero bytes up to a multiple of 8 bytes, 
+ * followed by the limbs, little-endian. every serialized value is a multiple of 8 bytes 
+ * long, so in an 8-byte aligned buffer the limbs of all values are aligned, and a 
+ * BigIntView can point straight at them.
+ */
+
+// version byte of the serialized form
+const uint8_t SERIALIZATION_VERSION = 1;
+
 /**
- * @brief returns negative of the BigInt object.
+ * @brief Construct a new BigIntView:: BigIntView object of zero
  * 
- * @return BigInt 
  */
-BigInt BigInt::operator-() const 
+BigIntView::BigIntView() 
+    : limbs(nullptr), count(0), sign('+')
 {
-    BigInt res;
-    if(abs_value == "0")
-        return res;
-    else
-    {
-        res.abs_value = abs_value;
-        res.sign = (sign == '-') ? '+' : '-';
-        return res;
-    }
 }
 
 /**
- * @brief doesn't do anything to the input BigInt. implemented solely 
- * for completeness.
+ * @brief Construct a new BigIntView:: BigIntView object of the limbs of a BigInt
  * 
- * @return BigInt 
+ * @param other 
  */
-BigInt BigInt::operator+() const 
+BigIntView::BigIntView(const BigInt& other) 
+    : limbs(other.get_limbs().data()), count(other.get_limbs().size()), sign(other.get_sign())
 {
-    return *this;
 }
 
-/**********************************************************************
-************************* ADDITION (+= +) *****************************
-**********************************************************************/
+/**
+ * @brief Construct a new BigIntView:: BigIntView object of limbs and a sign
+ * 
+ * @param limbs little-endian 64-bit limbs without leading zero limbs
+ * @param count 
+ * @param sign '+' or '-', always '+' for zero
+ */
+BigIntView::BigIntView(const uint64_t* limbs, size_t count, char sign) 
+    : limbs(limbs), count(count), sign(sign)
+{
+}
 
 /**
- * @brief implementing operator += between two BigInt objects
- * it uses the auxiliary functions positive_sum and positive_subtract 
+ * @brief get sign of a BigIntView object
  * 
- * @param other 
- * @return BigInt& sum of inputs
+ * @return char 
  */
-BigInt& BigInt::operator+=(const BigInt& other)
+char BigIntView::get_sign() const
 {
-    if(sign == other.sign)
-    {
-        abs_value = positive_sum(abs_value, other.abs_value);
-        return *this;
-    }
-    else
-    {
-        if(is_first_abs_value_greater(abs_value, other.abs_value))
-        {
-            abs_value = positive_subtract(abs_value, other.abs_value);
-            return *this;
-        }
-        else
-        {
-            abs_value = positive_subtract(other.abs_value, abs_value);
-            sign = sign == '+'? '-': '+';
-            return *this;
-        }
-    }
+    return sign;
 }
 
 /**
- * @brief implementing operator += between BigInt objects and string objects
+ * @brief get the magnitude of a BigIntView object as little-endian 64-bit limbs
  * 
- * @param other 
- * @return BigInt& sum of inputs
+ * @return const uint64_t* 
  */
-BigInt& BigInt::operator+=(const string& other)
+const uint64_t* BigIntView::get_limbs() const
 {
-    *this += BigInt(other);
-    return *this;
+    return limbs;
 }
 
 /**
- * @brief implementing operator += between BigInt objects and 
- * 64-bit integer objects
+ * @brief get the number of limbs of a BigIntView object
  * 
- * @param other 
- * @return BigInt& sum of inputs
+ * @return size_t 
  */
-BigInt& BigInt::operator+=(const int64_t& other)
+size_t BigIntView::size() const
 {
-    *this += BigInt(other);
-    return *this;
+    return count;
 }
 
 /**
- * @brief adding two BigInt objects
+ * @brief copies the value of a BigIntView object into a new BigInt
+ * 
+ * @return BigInt 
+ */
+BigInt BigIntView::to_bigint() const
+{
+    BigInt result;
+    result.limbs.resize(count);
+    copy(limbs, limbs + count, result.limbs.data());
+    result.sign = sign;
+    return result;
+}
+
+/**
+ * @brief signed sum of two magnitudes given as limbs, r = a + b
+ * 
+ * @param r receives the magnitude of the sum
+ * @param a 
+ * @param an 
+ * @param a_sign 
+ * @param b 
+ * @param bn 
+ * @param b_sign 
+ * @return char:: sign of the sum
+ */
+char signed_add_limbs(limb_vector& r, const uint64_t* a, size_t an, char a_sign, 
+                      const uint64_t* b, size_t bn, char b_sign)
+{
+    if (an < bn or (a_sign != b_sign and limbs_cmp(a, an, b, bn) < 0))
+    {
+        swap(a, b);
+        swap(an, bn);
+        swap(a_sign, b_sign);
+    }
+    if (bn == 0)
+    {
+        r.resize(an);
+        copy(a, a + an, r.data());
+        return a_sign;
+    }
+    if (a_sign == b_sign)
+    {
+        r.resize(an + 1);
+        r[an] = limbs_add(r.data(), a, an, b, bn);
+    }
+    else
+    {
+        r.resize(an);
+        limbs_sub(r.data(), a, an, b, bn);
+    }
+    normalize_limbs(r);
+    return r.empty() ? '+' : a_sign;
+}
+
+/**
+ * @brief adding views of BigInt objects, straight from their limbs
  * 
  * @param lhs left operand
  * @param rhs right operand
  * @return BigInt 
  */
-BigInt operator+(BigInt lhs, const BigInt& rhs)
+BigInt operator+(const BigIntView& lhs, const BigIntView& rhs)
 {
-    return lhs += rhs;
+    BigInt result;
+    result.sign = signed_add_limbs(result.limbs, lhs.get_limbs(), lhs.size(), lhs.get_sign(), 
+                                   rhs.get_limbs(), rhs.size(), rhs.get_sign());
+    return result;
 }
 
 /**
- * @brief adding BigInt object to string objects
+ * @brief subtracting views of BigInt objects, straight from their limbs
  * 
  * @param lhs left operand
  * @param rhs right operand
  * @return BigInt 
  */
-BigInt operator+(const BigInt& lhs, const string& rhs)
+BigInt operator-(const BigIntView& lhs, const BigIntView& rhs)
 {
-    return lhs + BigInt(rhs);
+    BigInt result;
+    result.sign = signed_add_limbs(result.limbs, lhs.get_limbs(), lhs.size(), lhs.get_sign(), 
+                                   rhs.get_limbs(), rhs.size(), rhs.get_sign() == '-' ? '+' : '-');
+    return result;
 }
 
 /**
- * @brief adding string object to BigInt objects
+ * @brief multiplying views of BigInt objects, straight from their limbs
  * 
  * @param lhs left operand
  * @param rhs right operand
  * @return BigInt 
  */
-BigInt operator+(const string& lhs, const BigInt& rhs)
+BigInt operator*(const BigIntView& lhs, const BigIntView& rhs)
+{
+    BigInt result;
+    if (lhs.size() == 0 or rhs.size() == 0)
+        return result;
+
+    const BigIntView& longer = lhs.size() >= rhs.size() ? lhs : rhs;
+    const BigIntView& shorter = lhs.size() >= rhs.size() ? rhs : lhs;
+    result.limbs.resize(longer.size() + shorter.size());
+    limb_vector scratch(mul_scratch_size(longer.size(), shorter.size()));
+    limbs_mul(result.limbs.data(), longer.get_limbs(), longer.size(), shorter.get_limbs(), 
+              shorter.size(), scratch.data());
+    normalize_limbs(result.limbs);
+    result.sign = lhs.get_sign() == rhs.get_sign() ? '+' : '-';
+    return result;
+}
+
+/**
+ * @brief compares two views of BigInt objects
+ * 
+ * @param lhs 
+ * @param rhs 
+ * @return int:: negative, zero or positive as lhs is less than, equal to or greater than rhs
+ */
+int compare_views(const BigIntView& lhs, const BigIntView& rhs)
+{
+    if (lhs.get_sign() != rhs.get_sign())
+        return lhs.get_sign() == '-' ? -1 : 1;
+    int magnitude = limbs_cmp(lhs.get_limbs(), lhs.size(), rhs.get_limbs(), rhs.size());
+    return lhs.get_sign() == '-' ? -magnitude : magnitude;
+}
+
+/**
+ * @brief view == view
+ * 
+ * @return true if yes
+ * @return false if no
+ */
+bool operator==(const BigIntView& lhs, const BigIntView& rhs)
+{
+    return compare_views(lhs, rhs) == 0;
+}
+
+/**
+ * @brief view != view
+ * 
+ * @return true if yes
+ * @return false if no
+ */
+bool operator!=(const BigIntView& lhs, const BigIntView& rhs)
+{
+    return compare_views(lhs, rhs) != 0;
+}
+
+/**
+ * @brief view < view
+ * 
+ * @return true if yes
+ * @return false if no
+ */
+bool operator<(const BigIntView& lhs, const BigIntView& rhs)
+{
+    return compare_views(lhs, rhs) < 0;
+}
+
+/**
+ * @brief view > view
+ * 
+ * @return true if yes
+ * @return false if no
+ */
+bool operator>(const BigIntView& lhs, const BigIntView& rhs)
 {
-    return BigInt(lhs) + rhs;
+    return compare_views(lhs, rhs) > 0;
 }
 
 /**
- * @brief adding BigInt object to 64-bit integer objects
+ * @brief view <= view
  * 
- * @param lhs left operand
- * @param rhs right operand
- * @return BigInt 
+ * @return true if yes
+ * @return false if no
  */
-BigInt operator+(const BigInt& lhs, const int64_t& rhs)
+bool operator<=(const BigIntView& lhs, const BigIntView& rhs)
 {
-    return lhs + BigInt(rhs);
+    return compare_views(lhs, rhs) <= 0;
 }
 
 /**
- * @brief adding 64-bit integer objects to BigInt object
+ * @brief view >= view
  * 
- * @param lhs left operand
- * @param rhs right operand
- * @return BigInt 
+ * @return true if yes
+ * @return false if no
  */
-BigInt operator+(const int64_t& lhs, BigInt rhs)
+bool operator>=(const BigIntView& lhs, const BigIntView& rhs)
 {
-    return BigInt(lhs) + rhs;
+    return compare_views(lhs, rhs) >= 0;
 }
 
-/**********************************************************************
-************************ SUBTRACTION (- -=) ***************************
-**********************************************************************/
-
 /**
- * @brief implementing operator -= between two BigInt objects
- * it uses the auxiliary functions positive_sum and positive_subtract 
+ * @brief output stream of a view, in decimal
  * 
- * @param other 
- * @return BigInt& 
+ * @param out reference to ostream
+ * @param x 
+ * @return ostream& 
  */
-BigInt& BigInt::operator-=(const BigInt& other)
+ostream& operator<<(ostream& out, const BigIntView& x)
 {
-    if(sign != other.sign)
-    {
-        abs_value = positive_sum(abs_value, other.abs_value);
-        return *this;
-    }
-    else
-    {
-        if(is_first_abs_value_greater(abs_value, other.abs_value))
-        {
-            abs_value = positive_subtract(abs_value, other.abs_value);
-            return *this;
-        }
-        else
-        {
-            abs_value = positive_subtract(other.abs_value, abs_value);
-            sign = sign == '+'? '-': '+';
-            return *this;
-        }
-    }
+    return out << x.to_bigint();
 }
 
 /**
- * @brief implementing operator -= between BigInt objects and string objects
+ * @brief size of the header of the serialized form: version, varint, sign and padding
  * 
- * @param other 
- * @return BigInt& sum of inputs
+ * @param count number of limbs
+ * @return size_t:: a multiple of 8
  */
-BigInt& BigInt::operator-=(const string& other)
+size_t serialized_header_size(size_t count)
 {
-    *this -= BigInt(other);
-    return *this;
+    size_t varint_bytes = 1;
+    for (size_t rest = count >> 7; rest != 0; rest >>= 7)
+        varint_bytes++;
+    return (2 + varint_bytes + 7) / 8 * 8;
 }
 
 /**
- * @brief implementing operator -= between BigInt objects and 
- * 64-bit integer objects
+ * @brief number of bytes of the serialized form of a BigInt object or a view
  * 
- * @param other 
- * @return BigInt& sum of inputs
+ * @param x 
+ * @return size_t 
  */
-BigInt& BigInt::operator-=(const int64_t& other)
+size_t serialized_size(const BigIntView& x)
 {
-    *this -= BigInt(other);
-    return *this;
+    return serialized_header_size(x.size()) + 8 * x.size();
 }
 
 /**
- * @brief subtracting two BigInt objects
+ * @brief writes the serialized form of a BigInt object or a view into a buffer
  * 
- * @param lhs left operand
- * @param rhs right operand
- * @return BigInt 
+ * @param x 
+ * @param buffer 
+ * @param capacity size of the buffer, throws if the serialized form doesn't fit
+ * @return size_t:: number of bytes written
  */
-BigInt operator-(BigInt lhs, const BigInt& rhs)
+size_t serialize(const BigIntView& x, uint8_t* buffer, size_t capacity)
 {
-    return lhs -= rhs;
+    size_t header = serialized_header_size(x.size());
+    size_t size = header + 8 * x.size();
+    if (capacity < size)
+        throw invalid_argument("Buffer too small!");
+
+    size_t pos = 0;
+    buffer[pos++] = SERIALIZATION_VERSION;
+    size_t rest = x.size();
+    do
+    {
+        buffer[pos++] = uint8_t(rest & 0x7F) | (rest >= 0x80 ? 0x80 : 0);
+        rest >>= 7;
+    } while (rest != 0);
+    buffer[pos++] = x.get_sign() == '-' ? 1 : 0;
+    fill(buffer + pos, buffer + header, 0);
+
+#if defined(__BYTE_ORDER__) and __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        uint64_t limb = __builtin_bswap64(x.get_limbs()[i]);
+        memcpy(buffer + header + 8 * i, &limb, 8);
+    }
+#else
+    if (x.size() != 0)
+        memcpy(buffer + header, x.get_limbs(), 8 * x.size());
+#endif
+    return size;
 }
 
 /**
- * @brief subtracting BigInt object to string objects
+ * @brief reads and checks the header of a serialized value
  * 
- * @param lhs left operand
- * @param rhs right operand
- * @return BigInt 
+ * @param buffer 
+ * @param size size of the buffer, which may go on after the value
+ * @param count receives the number of limbs
+ * @param sign receives the sign
+ * @return size_t:: size of the header, the limbs follow it
  */
-BigInt operator-(const BigInt& lhs, const string& rhs)
+size_t read_serialized_header(const uint8_t* buffer, size_t size, size_t& count, char& sign)
 {
-    return lhs - BigInt(rhs);
+    if (size < 8 or buffer[0] != SERIALIZATION_VERSION)
+        throw invalid_argument("Not a serialized BigInt!");
+
+    count = 0;
+    size_t pos = 1;
+    for (unsigned shift = 0; ; shift += 7)
+    {
+        if (pos == size or shift > 63)
+            throw invalid_argument("Not a serialized BigInt!");
+        uint8_t byte = buffer[pos++];
+        // the varint must be minimal: no trailing zero byte, and no bits beyond 64
+        if ((byte == 0 and shift != 0) or (shift == 63 and byte > 1))
+            throw invalid_argument("Not a serialized BigInt!");
+        count |= size_t(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            break;
+    }
+    // the sign byte and the zero padding must end inside the header
+    size_t header = serialized_header_size(count);
+    if (header > size or pos >= header or buffer[pos] > 1 or count > (size - header) / 8)
+        throw invalid_argument("Not a serialized BigInt!");
+    sign = buffer[pos] == 1 ? '-' : '+';
+    for (size_t i = pos + 1; i < header; i++)
+        if (buffer[i] != 0)
+            throw invalid_argument("Not a serialized BigInt!");
+
+    // the limbs must be normalized, and zero positive
+    uint64_t top = 0;
+    if (count != 0)
+        memcpy(&top, buffer + header + 8 * (count - 1), 8);
+    if ((count == 0 and sign == '-') or (count != 0 and top == 0))
+        throw invalid_argument("Not a serialized BigInt!");
+    return header;
 }
 
 /**
- * @brief subtracting string object to BigInt objects
+ * @brief reads a serialized value into a new BigInt object
  * 
- * @param lhs left operand
- * @param rhs right operand
+ * @param buffer 
+ * @param size size of the buffer, which may go on after the value
  * @return BigInt 
  */
-BigInt operator-(const string& lhs, const BigInt& rhs)
+BigInt deserialize(const uint8_t* buffer, size_t size)
 {
-    return BigInt(lhs) - rhs;
+    size_t count;
+    char sign;
+    size_t header = read_serialized_header(buffer, size, count, sign);
+    BigInt result;
+    result.limbs.resize(count);
+    if (count != 0)
+        memcpy(result.limbs.data(), buffer + header, 8 * count);
+#if defined(__BYTE_ORDER__) and __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    for (size_t i = 0; i < count; i++)
+        result.limbs[i] = __builtin_bswap64(result.limbs[i]);
+#endif
+    result.sign = sign;
+    return result;
 }
 
 /**
- * @brief subtracting BigInt object to 64-bit integer objects
+ * @brief reads a serialized value as a view of the limbs inside the buffer, without a 
+ * copy. the buffer must outlive the view
  * 
- * @param lhs left operand
- * @param rhs right operand
- * @return BigInt 
+ * @param buffer 
+ * @param size size of the buffer, which may go on after the value
+ * @return BigIntView 
  */
-BigInt operator-(const BigInt& lhs, const int64_t& rhs)
+BigIntView deserialize_view(const uint8_t* buffer, size_t size)
 {
-    return lhs - BigInt(rhs);
+#if defined(__BYTE_ORDER__) and __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    throw invalid_argument("Views of serialized limbs need a little-endian machine!");
+#endif
+    size_t count;
+    char sign;
+    size_t header = read_serialized_header(buffer, size, count, sign);
+    if (reinterpret_cast<uintptr_t>(buffer + header) % alignof(uint64_t) != 0)
+        throw invalid_argument("Serialized limbs aren't 8-byte aligned!");
+    return BigIntView(reinterpret_cast<const uint64_t*>(buffer + header), count, sign);
 }
 
+/**********************************************************************
+************************ MEMORY-MAPPED FILES **************************
+**********************************************************************/
+
+/*
+ * save_to_file writes the serialized form (see serialize) through a shared mapping of a 
+ * temporary file, flushes it and renames it over the target, so a crash never leaves a 
+ * half-written checkpoint behind. the file's space is reserved before it is mapped, so a 
+ * full disk is an error rather than a SIGBUS. map_file maps the file back privately and 
+ * read-only: the mapping is page-aligned, so the limbs are aligned and BigIntView points 
+ * straight at them. both hint the kernel that the pages are used sequentially.
+ */
+
 /**
- * @brief subtracting 64-bit integer objects to BigInt object
+ * @brief Construct a new BigIntMappedFile:: BigIntMappedFile object by mapping a file 
+ * written by save_to_file
  * 
- * @param lhs left operand
- * @param rhs right operand
- * @return BigInt 
+ * @param path 
  */
-BigInt operator-(const int64_t& lhs, BigInt rhs)
+BigIntMappedFile::BigIntMappedFile(const string& path) 
+    : mapping(nullptr), length(0)
 {
-    return BigInt(lhs) - rhs;
+#ifdef BIGINT_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("Can't open " + path + "!");
+    struct stat status;
+    if (fstat(fd, &status) != 0 or status.st_size == 0)
+    {
+        close(fd);
+        throw invalid_argument("Not a serialized BigInt!");
+    }
+    length = size_t(status.st_size);
+    mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        throw runtime_error("Can't map " + path + "!");
+    }
+    madvise(mapping, length, MADV_SEQUENTIAL);
+    try
+    {
+        value = deserialize_view(static_cast<const uint8_t*>(mapping), length);
+    }
+    catch (...)
+    {
+        release();
+        throw;
+    }
+#else
+    throw runtime_error("Memory-mapped files need a POSIX system!");
+#endif
 }
 
 /**
- * @brief multiplying two BigInt objects
+ * @brief move constructor, takes over the mapping of other
  * 
- * @param lhs 
- * @param rhs 
- * @return BigInt 
+ * @param other 
  */
-
-/**********************************************************************
-********************** MULTIPLICATION (* *=) **************************
-**********************************************************************/
+BigIntMappedFile::BigIntMappedFile(BigIntMappedFile&& other) noexcept 
+    : mapping(other.mapping), length(other.length), value(other.value)
+{
+    other.mapping = nullptr;
+    other.length = 0;
+    other.value = BigIntView();
+}
 
 /**
- * @brief implementing operator *= between two BigInt objects
- * it uses the auxiliary function positive_multiply 
+ * @brief move assignment, unmaps the current file and takes over the mapping of other
  * 
  * @param other 
- * @return BigInt& 
+ * @return BigIntMappedFile& 
  */
-BigInt& BigInt::operator*=(const BigInt& other) 
-{   
-    sign = sign == other.sign ? '+' : '-';
-    abs_value = positive_multiply(abs_value, other.abs_value);
+BigIntMappedFile& BigIntMappedFile::operator=(BigIntMappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        swap(mapping, other.mapping);
+        swap(length, other.length);
+        swap(value, other.value);
+    }
     return *this;
 }
 
+BigIntMappedFile::~BigIntMappedFile()
+{
+    release();
+}
+
 /**
- * @brief implementing operator *= between BigInt objects and string objects
+ * @brief unmaps the file if it is mapped
  * 
- * @param other 
- * @return BigInt& sum of inputs
  */
-BigInt& BigInt::operator*=(const string& other)
+void BigIntMappedFile::release()
 {
-    *this *= BigInt(other);
-    return *this;
+#ifdef BIGINT_MMAP
+    if (mapping != nullptr)
+        munmap(mapping, length);
+#endif
+    mapping = nullptr;
+    length = 0;
+    value = BigIntView();
 }
 
 /**
- * @brief implementing operator *= between BigInt objects and 
- * 64-bit integer objects
+ * @brief the value in the mapped file, valid while the mapping lives
  * 
- * @param other 
- * @return BigInt& sum of inputs
+ * @return const BigIntView& 
  */
-BigInt& BigInt::operator*=(const int64_t& other)
+const BigIntView& BigIntMappedFile::view() const
 {
-    *this *= BigInt(other);
-    return *this;
+    return value;
 }
 
-BigInt operator*(BigInt lhs, const BigInt& rhs)
+/**
+ * @brief copies the value in the mapped file into a new BigInt
+ * 
+ * @return BigInt 
+ */
+BigInt BigIntMappedFile::to_bigint() const
 {
-    return lhs *= rhs;
+    return value.to_bigint();
 }
 
 /**
- * @brief multiplying BigInt object to string objects
+ * @brief maps a file written by save_to_file, read-only and without a copy
  * 
- * @param lhs left operand
- * @param rhs right operand
- * @return BigInt 
+ * @param path 
+ * @return BigIntMappedFile 
  */
-BigInt operator*(const BigInt& lhs, const string& rhs)
+BigIntMappedFile BigInt::map_file(const string& path)
 {
-    return lhs * BigInt(rhs);
+    return BigIntMappedFile(path);
 }
 
+#ifdef BIGINT_MMAP
 /**
- * @brief multiplying string object to BigInt objects
+ * @brief reserves the blocks of a new file of a given size, so that writing it through a 
+ * mapping can't fail for lack of space (which would raise SIGBUS instead of an error)
  * 
- * @param lhs left operand
- * @param rhs right operand
- * @return BigInt 
+ * @param fd 
+ * @param size 
+ * @return true if the space is reserved
+ * @return false else
  */
-BigInt operator*(const string& lhs, const BigInt& rhs)
+bool allocate_file(int fd, size_t size)
 {
-    return BigInt(lhs) * rhs;
+#ifdef __APPLE__
+    fstore_t store = {F_ALLOCATEALL, F_PEOFPOSMODE, 0, off_t(size), 0};
+    return fcntl(fd, F_PREALLOCATE, &store) != -1 and ftruncate(fd, off_t(size)) == 0;
+#else
+    return posix_fallocate(fd, 0, off_t(size)) == 0;
+#endif
 }
 
 /**
- * @brief multiplying BigInt object to 64-bit integer objects
+ * @brief flushes the directory that holds a path, so that a rename into it survives a crash
  * 
- * @param lhs left operand
- * @param rhs right operand
- * @return BigInt 
+ * @param path 
+ * @return true if the directory is flushed, or its file system can't flush directories
+ * @return false else
  */
-BigInt operator*(const BigInt& lhs, const int64_t& rhs)
+bool sync_directory(const string& path)
 {
-    return lhs * BigInt(rhs);
+    size_t slash = path.find_last_of('/');
+    string directory = slash == string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int fd = open(directory.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    bool synced = fsync(fd) == 0 or errno == EINVAL;
+    close(fd);
+    return synced;
 }
+#endif
 
 /**
- * @brief multiplying 64-bit integer objects to BigInt object
+ * @brief writes the serialized form of a BigInt object to a file through a memory 
+ * mapping. the file is written under a unique temporary name next to path, with its 
+ * space reserved first, and replaces path only once it is completely on disk
  * 
- * @param lhs left operand
- * @param rhs right operand
- * @return BigInt 
+ * @param path 
  */
-BigInt operator*(const int64_t& lhs, BigInt rhs)
+void BigInt::save_to_file(const string& path) const
 {
-    return BigInt(lhs) * rhs;
+#ifdef BIGINT_MMAP
+    string temporary = path + ".XXXXXX";
+    size_t size = serialized_size(*this);
+    int fd = mkstemp(&temporary[0]);
+    if (fd < 0)
+        throw runtime_error("Can't create a temporary file for " + path + "!");
+    void* mapping = MAP_FAILED;
+    if (fchmod(fd, 0644) == 0 and allocate_file(fd, size))
+        mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        close(fd);
+        unlink(temporary.c_str());
+        throw runtime_error("Can't allocate and map " + temporary + "!");
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    serialize(*this, static_cast<uint8_t*>(mapping), size);
+    bool written = msync(mapping, size, MS_SYNC) == 0;
+    munmap(mapping, size);
+    written = fsync(fd) == 0 and written;
+    written = close(fd) == 0 and written;
+    if (not written or rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        unlink(temporary.c_str());
+        throw runtime_error("Can't write " + path + "!");
+    }
+    if (not sync_directory(path))
+        throw runtime_error("Can't flush the directory of " + path + "!");
+#else
+    throw runtime_error("Memory-mapped files need a POSIX system!");
+#endif
 }
 
 /**********************************************************************
@@ -944,7 +7633,7 @@ BigInt operator*(const int64_t& lhs, BigInt rhs)
 bool operator==(const BigInt& lhs, const BigInt& rhs)
 {
     return (lhs.get_sign() == rhs.get_sign() and 
-            lhs.get_abs_value() == rhs.get_abs_value());
+            lhs.get_limbs() == rhs.get_limbs());
 }
 
 /**
@@ -956,9 +7645,7 @@ bool operator==(const BigInt& lhs, const BigInt& rhs)
  */
 bool operator==(const BigInt& lhs, const string& rhs)
 {
-    BigInt temp_big_int(rhs);
-    return ((lhs.get_sign() == temp_big_int.get_sign()) 
-            and (lhs.get_abs_value() == temp_big_int.get_abs_value()));
+    return lhs == BigInt(rhs);
 }
 
 /**
@@ -970,9 +7657,7 @@ bool operator==(const BigInt& lhs, const string& rhs)
  */
 bool operator==(const string& lhs, const BigInt& rhs)
 {
-    BigInt temp_big_int(lhs);
-    return ((temp_big_int.get_sign() == rhs.get_sign()) 
-            and (temp_big_int.get_abs_value() == rhs.get_abs_value()));
+    return BigInt(lhs) == rhs;
 }
 
 /**
@@ -984,9 +7669,7 @@ bool operator==(const string& lhs, const BigInt& rhs)
  */
 bool operator==(const BigInt& lhs, const int64_t& rhs)
 {
-    BigInt temp_big_int(rhs);
-    return ((lhs.get_sign() == temp_big_int.get_sign()) 
-            and (lhs.get_abs_value() == temp_big_int.get_abs_value()));
+    return lhs == BigInt(rhs);
 }
 
 /**
@@ -998,9 +7681,7 @@ bool operator==(const BigInt& lhs, const int64_t& rhs)
  */
 bool operator==(const int64_t& lhs, const BigInt& rhs)
 {
-    BigInt temp_big_int(lhs);
-    return ((temp_big_int.get_sign() == rhs.get_sign()) 
-            and (temp_big_int.get_abs_value() == rhs.get_abs_value()));
+    return BigInt(lhs) == rhs;
 }
 
 /**
@@ -1074,8 +7755,8 @@ bool operator>(const BigInt& lhs, const BigInt& rhs)
 {
     if(lhs == rhs)
         return false;
-    bool is_lhs_abs_value_greater = is_first_abs_value_greater(lhs.get_abs_value(), 
-                                                               rhs.get_abs_value());
+    bool is_lhs_abs_value_greater = is_first_abs_value_greater(lhs.get_limbs(), 
+                                                               rhs.get_limbs());
     if (lhs.get_sign() == rhs.get_sign())
         return lhs.get_sign() == '+' ? is_lhs_abs_value_greater : !is_lhs_abs_value_greater;
     else
@@ -1310,6 +7991,204 @@ bool operator<=(const int64_t& lhs, const BigInt& rhs)
     return !(lhs > rhs);
 }
 
+/**********************************************************************
+*********************** INCREMENTAL PARSING ***************************
+**********************************************************************/
+
+/**
+ * @brief checks if a character is whitespace, which may surround a fed integer
+ * 
+ * @param c 
+ * @return true if yes
+ * @return false if no
+ */
+bool is_space(char c)
+{
+    return c == ' ' or c == '\t' or c == '\n' or c == '\r' or c == '\v' or c == '\f';
+}
+
+/**
+ * @brief Construct a new BigIntParser:: BigIntParser object. blocks hold the smallest 
+ * power of two of chunks from radix_dc_threshold, so they are converted a chunk at a time
+ * 
+ * @param base from 2 to 36, throws otherwise
+ */
+BigIntParser::BigIntParser(int base) 
+    : powers(base)
+{
+    if (base < 2 or base > 36)
+        throw invalid_argument("Base must be between 2 and 36!");
+    this->base = base;
+    block_level = 0;
+    while ((size_t(1) << block_level) < radix_dc_threshold)
+        block_level++;
+    block_digits = radix_chunk_of(base).digits << block_level;
+    started = negative = any_digit = significant = ended = false;
+}
+
+/**
+ * @brief high b^digits + low, by a multiplication with a cached power, or a shift in the 
+ * bases that are powers of two
+ * 
+ * @param high 
+ * @param low 
+ * @param digits number of digits of low, block_digits 2^level
+ * @param level SIZE_MAX if digits is any other number
+ * @return limb_vector 
+ */
+limb_vector BigIntParser::combine(const limb_vector& high, const limb_vector& low, size_t digits, size_t level)
+{
+    if (high.empty())
+        return low;
+    limb_vector result;
+    if ((base & (base - 1)) == 0)
+        result = shift_left_bits(high, digits * __builtin_ctz(base));
+    else if (level == SIZE_MAX)
+        result = positive_multiply(high, positive_power(limb_vector(1, base), digits));
+    else
+        result = positive_multiply(high, powers.get(block_level + level, false).power);
+    positive_add_in_place(result, low);
+    return result;
+}
+
+/**
+ * @brief converts a full block of digits and merges it into the parts. if whitespace cuts 
+ * the block short, the digits before it are the last ones and stay pending
+ * 
+ * @param digits 
+ * @param n 
+ */
+void BigIntParser::convert(const char* digits, size_t n)
+{
+    uint64_t invalid = 0;
+    limb_vector block = digits_to_limbs_basic(digits, n, base, invalid);
+    if (invalid != 0)
+    {
+        size_t end = 0;
+        while (digit_value(digits[end]) < base)
+            end++;
+        for (size_t i = end; i < n; i++)
+            if (not is_space(digits[i]))
+                throw invalid_argument("Not a valid integer!");
+        pending.assign(digits, end);
+        ended = true;
+        return;
+    }
+
+    parts.push_back(move(block));
+    levels.push_back(0);
+    // two parts of the same level merge into one of the next level
+    while (levels.size() >= 2 and levels[levels.size() - 1] == levels[levels.size() - 2])
+    {
+        size_t level = levels.back();
+        limb_vector merged = combine(parts[parts.size() - 2], parts.back(), block_digits << level, level);
+        parts.pop_back();
+        levels.pop_back();
+        parts.back() = move(merged);
+        levels.back() = level + 1;
+    }
+}
+
+/**
+ * @brief parses the next characters of an integer
+ * 
+ * @param data 
+ * @param n 
+ */
+void BigIntParser::feed(const char* data, size_t n)
+{
+    size_t i = 0;
+    // whitespace, the sign and the leading zeros, one by one
+    for (; i < n and not significant and not ended; i++)
+    {
+        char c = data[i];
+        if (is_space(c))
+        {
+            // whitespace before the integer is skipped, after it ends the integer
+            ended = started;
+            continue;
+        }
+        if ((c == '+' or c == '-') and not started)
+            negative = c == '-';
+        else if (c == '0')
+            any_digit = true;
+        else if (digit_value(c) < base)
+            any_digit = significant = true;
+        else
+            throw invalid_argument("Not a valid integer!");
+        started = true;
+        if (significant)
+            break;
+    }
+
+    while (i < n and not ended)
+    {
+        if (pending.empty() and n - i >= block_digits)
+        {
+            // whole blocks are converted straight from the input
+            convert(data + i, block_digits);
+            i += block_digits;
+            continue;
+        }
+        size_t take = min(block_digits - pending.size(), n - i);
+        pending.append(data + i, take);
+        i += take;
+        if (pending.size() == block_digits)
+        {
+            string block;
+            swap(block, pending);
+            convert(block.data(), block.size());
+        }
+    }
+    for (; i < n; i++)
+        if (not is_space(data[i]))
+            throw invalid_argument("Not a valid integer!");
+}
+
+/**
+ * @brief the integer fed so far. the pending digits are converted, and the parts are 
+ * combined from the most significant one with the powers the parser already computed. 
+ * the parser starts over once the integer is returned or found invalid
+ * 
+ * @return BigInt 
+ */
+BigInt BigIntParser::finish()
+{
+    // the pending digits may end with whitespace
+    size_t end = 0;
+    while (end < pending.size() and digit_value(pending[end]) < base)
+        end++;
+    bool valid = any_digit;
+    for (size_t i = end; i < pending.size(); i++)
+        if (not is_space(pending[i]))
+            valid = false;
+    if (not valid)
+    {
+        *this = BigIntParser(base);
+        throw invalid_argument("Not a valid integer!");
+    }
+
+    // each part is freed once it is combined
+    BigInt result;
+    for (size_t i = 0; i < parts.size(); i++)
+    {
+        limb_vector part = move(parts[i]);
+        if (i == 0)
+            result.limbs = move(part);
+        else
+            result.limbs = combine(result.limbs, part, block_digits << levels[i], levels[i]);
+    }
+    if (end != 0)
+    {
+        uint64_t invalid = 0;
+        limb_vector tail = digits_to_limbs_basic(pending.data(), end, base, invalid);
+        result.limbs = combine(result.limbs, tail, end, SIZE_MAX);
+    }
+    result.sign = (negative and !result.limbs.empty()) ? '-' : '+';
+    *this = BigIntParser(base);
+    return result;
+}
+
 /**********************************************************************
 ************************** INSERTION (<<) *****************************
 **********************************************************************/
@@ -1323,6 +8202,83 @@ bool operator<=(const int64_t& lhs, const BigInt& rhs)
  */
 ostream& operator<<(ostream& out, const BigInt& str)
 {
-    out << (str.sign == '-' ? '-' + str.abs_value : str.abs_value);
+    string abs_value = limbs_to_digits(str.limbs, 10);
+    out << (str.sign == '-' ? '-' + abs_value : abs_value);
     return out;
 }
+
+/**********************************************************************
+************************** EXTRACTION (>>) ****************************
+**********************************************************************/
+
+/**
+ * @brief input stream: skips whitespace, then reads an optional sign and the digits up to 
+ * the first other character, in the base set on the stream (hex, oct or dec). like int 
+ * extraction, a "0x" prefix is skipped in hex, and with no base set the prefix picks 
+ * the base ("0x" hex, "0" octal, otherwise decimal). the digits go through a 
+ * BigIntParser a piece at a time, so they are never all kept as text. sets failbit and 
+ * leaves x unchanged if there is no digit, or no digit after "0x"
+ * 
+ * @param in reference to istream
+ * @param x reference to BigInt
+ * @return istream& 
+ */
+istream& operator>>(istream& in, BigInt& x)
+{
+    istream::sentry sentry(in);
+    if (not sentry)
+        return in;
+
+    ios::fmtflags basefield = in.flags() & ios::basefield;
+    unsigned base = basefield == ios::hex ? 16 : basefield == ios::oct ? 8 : 10;
+    streambuf* buffer = in.rdbuf();
+    const int end_of_file = char_traits<char>::eof();
+    char piece[4096];
+    size_t filled = 0;
+    bool any_digit = false;
+
+    int c = buffer->sgetc();
+    if (c == '+' or c == '-')
+    {
+        piece[filled++] = char(c);
+        c = buffer->snextc();
+    }
+    // the leading '0' of a prefix is a digit in every base, but "0x" must be followed by 
+    // a hexadecimal digit
+    if (c == '0' and (basefield == ios::hex or basefield == 0))
+    {
+        piece[filled++] = '0';
+        any_digit = true;
+        c = buffer->snextc();
+        if (c == 'x' or c == 'X')
+        {
+            base = 16;
+            any_digit = false;
+            c = buffer->snextc();
+        }
+        else if (basefield == 0)
+            base = 8;
+    }
+    BigIntParser parser(base);
+    while (c != end_of_file and digit_value(char(c)) < base)
+    {
+        piece[filled++] = char(c);
+        any_digit = true;
+        if (filled == sizeof(piece))
+        {
+            parser.feed(piece, filled);
+            filled = 0;
+        }
+        c = buffer->snextc();
+    }
+    if (c == end_of_file)
+        in.setstate(ios::eofbit);
+    if (not any_digit)
+    {
+        in.setstate(ios::failbit);
+        return in;
+    }
+    parser.feed(piece, filled);
+    x = parser.finish();
+    return in;
+}
@@ -10,6 +10,7 @@
  */
 
 #include <iostream> 
+#include <sstream>
 #include <stdexcept>
 #include "bigint.hpp"
 
@@ -236,6 +237,110 @@ int main()
     bigint28 = int27 * bigint26;
     cout << "bigint28 = int27 * bigint26 = " << bigint28 << "\n";
 
+    // square of a BigInt object
+    BigInt bigint28_ = bigint26.square();
+    cout << "bigint28 = bigint26.square() = " << bigint28_ << "\n";
+
+    // BigInt object /= BigInt object
+    BigInt bigint28__("-216843452374924103934719744612844");
+    cout << "bigint28__ = " << bigint28__ << ", bigint26 = " << bigint26 << " -> doing bigint28__ /= bigint26 :: ";
+    bigint28__ /= bigint26;
+    cout << "bigint28__ = " << bigint28__ << "\n";
+
+    // BigInt object %= 64-bit integer object
+    BigInt bigint28___("-216843452374924103934719744612844");
+    bigint28___ %= int27;
+    cout << "bigint28___ %= int27 -> " << bigint28___ << "\n";
+
+    // BigInt object = BigInt object / string object, BigInt object = BigInt object % BigInt object
+    BigInt bigint28____ = bigint28_ / string27;
+    cout << "bigint28____ = bigint28_ / string27 = " << bigint28____ << "\n";
+    bigint28____ = bigint28_ % bigint27;
+    cout << "bigint28____ = bigint28_ % bigint27 = " << bigint28____ << "\n";
+
+    // quotient and remainder of one division
+    auto [quotient28, remainder28] = divmod(bigint28_, -bigint27);
+    cout << "divmod(bigint28_, -bigint27) = " << quotient28 << ", " << remainder28 << "\n";
+
+    // dividing by a divisor prepared once for many divisions
+    BigIntReciprocal reciprocal27(bigint27);
+    cout << "bigint28_ / reciprocal27 = " << bigint28_ / reciprocal27 << ", bigint28_ % reciprocal27 = " << bigint28_ % reciprocal27 << "\n";
+
+    // powers, powers of 10 are powers of 5 and a shift
+    cout << "pow(bigint26, 3) = " << pow(bigint26, 3) << ", pow(BigInt(-10), 25) = " << pow(BigInt(-10), 25) << "\n";
+
+    // modular exponentiation, the odd modulus of the second one is prepared once for many exponentiations
+    cout << "powmod(bigint26, bigint27, bigint28____) = " << powmod(bigint26, bigint27, bigint28____) << "\n";
+    BigIntMontgomery montgomery27(bigint27);
+    cout << "powmod(bigint26, 65537, montgomery27) = " << powmod(bigint26, 65537, montgomery27) << "\n";
+
+    // reducing products by a modulus prepared once, without divisions
+    BigIntModContext context27(bigint27);
+    BigInt bigint28_____ = bigint26 * bigint26 * bigint26;
+    context27.reduce(bigint28_____);
+    cout << "bigint26 * bigint26 * bigint26 reduced by context27 = " << bigint28_____ << "\n";
+
+    // integer roots
+    cout << "isqrt(bigint28_) = " << isqrt(bigint28_) << ", iroot(bigint28__, 3) = " << iroot(bigint28__, 3) << "\n";
+    cout << "is_perfect_square(bigint28_) = " << is_perfect_square(bigint28_) << ", is_perfect_square(bigint28_ + 1) = " << is_perfect_square(bigint28_ + 1) << "\n";
+
+    // greatest common divisor, cofactors and modular inverse
+    cout << "gcd(bigint28_, bigint28__) = " << gcd(bigint28_, bigint28__) << ", lcm(bigint26, int27) = " << lcm(bigint26, int27) << "\n";
+    auto [gcd26, s26, t26] = gcdext(bigint26, bigint27);
+    cout << "gcdext(bigint26, bigint27) = " << gcd26 << ", " << s26 << ", " << t26 << "\n";
+    cout << "invert(bigint26 + 1, bigint27) = " << invert(bigint26 + 1, bigint27) << "\n";
+
+    // factorials, binomial coefficients and products by balanced product trees
+    cout << "factorial(30) = " << factorial(30) << ", binomial(100, 30) = " << binomial(100, 30) << ", primorial(50) = " << primorial(50) << "\n";
+    cout << "product({bigint26, bigint27, -bigint28_}) = " << product({bigint26, bigint27, -bigint28_}) << "\n";
+
+    // Baillie-PSW probable prime test and the next prime
+    cout << "is_probable_prime(bigint27) = " << is_probable_prime(bigint27) << ", next_prime(bigint27) = " << next_prime(bigint27) << "\n";
+
+    // strings in other bases
+    cout << "bigint28.to_string(16) = " << bigint28.to_string(16) << ", from_string(\"-zz9\", 36) = " << from_string("-zz9", 36) << "\n";
+
+    // binary serialization, and a view of the limbs inside the buffer
+    vector<uint64_t> buffer28(serialized_size(bigint28) / 8);
+    uint8_t* bytes28 = reinterpret_cast<uint8_t*>(buffer28.data());
+    size_t size28 = serialize(-bigint28, bytes28, 8 * buffer28.size());
+    BigIntView view28 = deserialize_view(bytes28, size28);
+    cout << "serialize(-bigint28) takes " << size28 << " bytes, deserialize = " << deserialize(bytes28, size28) << ", view28 * bigint27 = " << view28 * bigint27 << "\n";
+
+    // a header with a non-minimal limb count is rejected
+    uint64_t malformed28[3] = {0x8080808080808101, 0x0000000000050000, 0};
+    try
+    {
+        deserialize(reinterpret_cast<uint8_t*>(malformed28), sizeof(malformed28));
+    }
+    catch(const exception& e)
+    {
+        cout << "deserialize(malformed28) throws: " << e.what() << "\n";
+    }
+
+    // saving to a file and mapping it back without parsing or copying
+    bigint28.save_to_file("BigIntCheckpoint.bin");
+    {
+        BigIntMappedFile mapped28 = BigInt::map_file("BigIntCheckpoint.bin");
+        cout << "BigInt::map_file(\"BigIntCheckpoint.bin\") = " << mapped28.view() << ", mapped28.view() - bigint27 = " << mapped28.view() - bigint27 << "\n";
+    }
+    remove("BigIntCheckpoint.bin");
+
+    // reading from a stream, and a parser fed in pieces
+    istringstream input28("  -216846168284839509308736769996644 0xff");
+    BigInt bigint28_read, bigint28_hex;
+    input28 >> bigint28_read >> hex >> bigint28_hex;
+    istringstream prefix28("0x1f 0xg");
+    BigInt bigint28_prefix;
+    prefix28 >> hex >> bigint28_prefix;
+    cout << "\"0x1f\" >> hex = " << bigint28_prefix;
+    prefix28 >> bigint28_prefix;
+    cout << ", \"0xg\" >> hex sets failbit ? " << (prefix28.fail() ? "Yes" : "No") << "\n";
+    BigIntParser parser28;
+    parser28.feed("2168461682848", 13);
+    parser28.feed("39509308736769996644\n", 21);
+    cout << "input28 >> = " << bigint28_read << ", " << bigint28_hex << ", parser28.finish() = " << parser28.finish() << "\n";
+
     // BigInt object == BigInt object
     BigInt bigint29("152341516164516");
     BigInt bigint30("152341516164516");